@@ -0,0 +1,204 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/async.h
+
+Created: 2026.10.18
+
+Description:
+	Asynchronous validation for slow validations, such as a remote lookup or
+	a large checksum. assign_async() hands the check to a worker pool and
+	returns at once. The caller carries on with other work and calls
+	commit() when it needs the result:
+
+		pending_assignment<safe_account> p = assign_async(account, number);
+		...
+		p.commit();   // waits, then assigns, or rethrows the validation's exception
+
+	The safe<> is not changed until commit(). Until then, readers see the
+	last committed value, and value() gives the provisional one. A failed
+	commit leaves the safe<> as it was, and a pending assignment that is
+	never committed is discarded. The validation runs on a worker, but the
+	assignment happens on the thread that calls commit(), so a safe<> needs
+	no more locking than usual.
+
+	A validation_pool has a fixed number of workers and a bounded queue;
+	submitting to a full queue blocks until a worker takes a task. Once
+	shutdown() or the destructor has started, submit() throws
+	std::logic_error rather than queue a task no worker would run.
+*/
+
+#ifndef SAFE_DATA_ASYNC_MPN_18OCT2026_HPP
+#define SAFE_DATA_ASYNC_MPN_18OCT2026_HPP
+
+#include "safe_data/safe.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace safe_data {
+
+class validation_pool {
+	validation_pool(validation_pool const&);
+	validation_pool& operator= (validation_pool const&);
+public:
+	// 0 threads uses every core
+	explicit validation_pool(unsigned threads = 0, std::size_t capacity = 1024) :
+		capacity_(capacity ? capacity : 1), stopping_(false)
+	{
+		if ( threads == 0 )
+			threads = std::thread::hardware_concurrency();
+		if ( threads == 0 )
+			threads = 1;
+		workers_.reserve(threads);
+		try {
+			for (unsigned t = 0; t < threads; ++t)
+				workers_.push_back(std::thread(&validation_pool::work, this));
+		}
+		catch (...) {
+			shutdown();
+			throw;
+		}
+	}
+
+	~validation_pool() { shutdown(); }
+
+	static validation_pool& shared()
+	{
+		static validation_pool pool;
+		return pool;
+	}
+
+	// stops taking tasks, runs the tasks already queued, then joins the workers
+	void shutdown()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stopping_ = true;
+		}
+		not_empty_.notify_all();
+		not_full_.notify_all();
+		for (std::size_t t = 0; t < workers_.size(); ++t)
+			if ( workers_[t].joinable() )
+				workers_[t].join();
+	}
+
+	unsigned    threads()  const { return static_cast<unsigned>(workers_.size()); }
+	std::size_t capacity() const { return capacity_; }
+
+	// blocks while the queue is full; an exception thrown by f is stored in the future
+	template <class F>
+	std::future<void> submit(F f)
+	{
+		std::shared_ptr<std::packaged_task<void()> > task =
+			std::make_shared<std::packaged_task<void()> >(std::move(f));
+		std::future<void> result = task->get_future();
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			while ( queue_.size() >= capacity_ && !stopping_ )
+				not_full_.wait(lock);
+			if ( stopping_ )
+				throw std::logic_error("validation_pool is shutting down");
+			queue_.push_back([task] { (*task)(); });
+		}
+		not_empty_.notify_one();
+		return result;
+	}
+
+private:
+	void work()
+	{
+		for (;;) {
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				while ( queue_.empty() && !stopping_ )
+					not_empty_.wait(lock);
+				if ( queue_.empty() )
+					return;
+				task = std::move(queue_.front());
+				queue_.pop_front();
+			}
+			not_full_.notify_one();
+			task();
+		}
+	}
+
+	std::size_t const                 capacity_;
+	bool                              stopping_;
+	std::deque<std::function<void()> > queue_;
+	std::mutex                        mutex_;
+	std::condition_variable           not_empty_;
+	std::condition_variable           not_full_;
+	std::vector<std::thread>          workers_;
+};
+
+
+template <class Safe>
+class pending_assignment {
+	pending_assignment(pending_assignment const&);
+	pending_assignment& operator= (pending_assignment const&);
+public:
+	typedef Safe                              safe_type;
+	typedef typename Safe::raw_type           raw_type;
+	typedef typename Safe::validation_type    validation_type;
+
+	static_assert(!std::is_reference<typename Safe::value_type>::value, "pending_assignment needs a value type");
+
+	pending_assignment(safe_type& target, raw_type value, validation_pool& pool) :
+		target_(&target), value_(std::make_shared<raw_type const>(std::move(value)))
+	{
+		std::shared_ptr<raw_type const> v(value_);
+		result_ = pool.submit([v] { validation_type::validate(*v); });
+	}
+	pending_assignment(pending_assignment&& other) :
+		target_(other.target_), value_(std::move(other.value_)), result_(std::move(other.result_))
+	{ other.target_ = 0; }
+
+	// the provisional value, not yet validated
+	raw_type const& value() const { return *value_; }
+
+	bool pending() const { return target_ != 0; }
+	bool ready() const { return result_.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+	void wait() const { result_.wait(); }
+
+// waits for the validation; assigns the value, or rethrows and leaves the target unchanged
+	safe_type& commit()
+	{
+		if ( !target_ )
+			throw std::logic_error("pending_assignment already committed or cancelled");
+		safe_type& target = *target_;
+		target_ = 0;
+		result_.get();
+		target = safe_type(unchecked, *value_);
+		return target;
+	}
+
+	void cancel() { target_ = 0; }
+
+private:
+	safe_type*                      target_;
+	std::shared_ptr<raw_type const> value_;
+	std::future<void>               result_;
+};
+
+template <class T, class V, class I>
+inline pending_assignment<safe<T,V,I> >
+	assign_async(safe<T,V,I>& s, typename safe<T,V,I>::raw_type value, validation_pool& pool = validation_pool::shared())
+{ return pending_assignment<safe<T,V,I> >(s, std::move(value), pool); }
+
+} // namespace safe_data
+
+#endif
@@ -0,0 +1,314 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/charset.h
+
+Created: 2026.10.18
+
+Description:
+	Character set validations for strings: ASCII, printable, alphanumeric,
+	digits, hex digits, any set of byte ranges, and UTF-8.
+
+		typedef safe<std::string, charset_validation<std::string, printable> > label;
+		typedef safe<std::string, utf8_validation<std::string> > text;
+
+	Byte ranges are checked 32 bytes at a time with AVX2 or 16 bytes at a
+	time with SSE2. Without either, the check falls back to portable code
+	that tests 8 bytes at a time for ASCII. UTF-8 skips runs of ASCII the
+	same way and decodes only the multi-byte sequences. Define
+	SAFE_DATA_NO_SIMD to force the portable code.
+
+	str_length_charset_validation checks the length and the characters
+	together, so a string is only scanned once. It throws two exception
+	types: length_exception_type for a string that is too long and
+	exception_type for a bad character. Both derive from std::logic_error.
+*/
+
+#ifndef SAFE_DATA_CHARSET_MPN_18OCT2026_HPP
+#define SAFE_DATA_CHARSET_MPN_18OCT2026_HPP
+
+#include "safe_data/safe_detail.h"
+#include "safe_data/exceptions.h"
+#include "safe_data/simd.h"
+
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace safe_data {
+namespace safe_detail {
+
+// number of leading bytes known to be ASCII, checked a block at a time;
+// the bytes after it may still be ASCII
+inline std::size_t ascii_prefix(char const* str, std::size_t size)
+{
+	std::size_t i = 0;
+#if defined(SAFE_DATA_SSE2)
+	for (; i + 16 <= size; i += 16) {
+		__m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(str + i));
+		if ( _mm_movemask_epi8(block) )
+			return i;
+	}
+#else
+	for (; i + 8 <= size; i += 8) {
+		unsigned long long block;
+		std::memcpy(&block, str + i, 8);
+		if ( block & 0x8080808080808080ULL )
+			return i;
+	}
+#endif
+	return i;
+}
+
+// inclusive byte ranges, as lower, upper pairs
+template <unsigned char... bounds> struct range_set;
+
+template <> struct range_set<> {
+	static bool contains(unsigned char) { return false; }
+#if defined(SAFE_DATA_SSE2)
+	static __m128i match(__m128i) { return _mm_setzero_si128(); }
+#endif
+#if defined(SAFE_DATA_AVX2)
+	static __m256i match(__m256i) { return _mm256_setzero_si256(); }
+#endif
+};
+
+template <unsigned char lower, unsigned char upper, unsigned char... rest>
+struct range_set<lower, upper, rest...> {
+	static_assert(lower <= upper, "char_ranges bounds must be lower, upper pairs");
+
+	static bool contains(unsigned char c)
+	{
+		return static_cast<unsigned char>(c - lower) <= upper - lower
+			|| range_set<rest...>::contains(c);
+	}
+
+	// c - lower <= upper - lower, unsigned, as min(c - lower, upper - lower) == c - lower
+#if defined(SAFE_DATA_SSE2)
+	static __m128i match(__m128i block)
+	{
+		__m128i const offset = _mm_sub_epi8(block, _mm_set1_epi8(static_cast<char>(lower)));
+		__m128i const in = _mm_cmpeq_epi8(
+			_mm_min_epu8(offset, _mm_set1_epi8(static_cast<char>(upper - lower))), offset);
+		return _mm_or_si128(in, range_set<rest...>::match(block));
+	}
+#endif
+#if defined(SAFE_DATA_AVX2)
+	static __m256i match(__m256i block)
+	{
+		__m256i const offset = _mm256_sub_epi8(block, _mm256_set1_epi8(static_cast<char>(lower)));
+		__m256i const in = _mm256_cmpeq_epi8(
+			_mm256_min_epu8(offset, _mm256_set1_epi8(static_cast<char>(upper - lower))), offset);
+		return _mm256_or_si256(in, range_set<rest...>::match(block));
+	}
+#endif
+};
+
+template <class Ranges>
+inline std::size_t first_not_in(char const* str, std::size_t size)
+{
+	std::size_t i = 0;
+#if defined(SAFE_DATA_AVX2)
+	for (; i + 32 <= size; i += 32) {
+		__m256i const block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(str + i));
+		unsigned const in = static_cast<unsigned>(_mm256_movemask_epi8(Ranges::match(block)));
+		if ( in != 0xFFFFFFFFu )
+			return i + trailing_zeros(~in);
+	}
+#endif
+#if defined(SAFE_DATA_SSE2)
+	for (; i + 16 <= size; i += 16) {
+		__m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(str + i));
+		unsigned const in = static_cast<unsigned>(_mm_movemask_epi8(Ranges::match(block)));
+		if ( in != 0xFFFFu )
+			return i + trailing_zeros(~in & 0xFFFFu);
+	}
+#endif
+	for (; i < size; ++i)
+		if ( !Ranges::contains(static_cast<unsigned char>(str[i])) )
+			return i;
+	return size;
+}
+
+// offset of the first byte of the first invalid UTF-8 sequence
+inline std::size_t first_not_utf8(char const* str, std::size_t size)
+{
+	unsigned char const* const s = reinterpret_cast<unsigned char const*>(str);
+	std::size_t i = 0;
+	while ( i < size ) {
+		i += ascii_prefix(str + i, size - i);
+		if ( i == size )
+			break;
+
+		unsigned char const c = s[i];
+		if ( c < 0x80 ) {
+			++i;
+			continue;
+		}
+
+		// sequence length and the allowed range of the second byte,
+		// which excludes overlong forms, surrogates and code points above 0x10FFFF
+		std::size_t len;
+		unsigned char lo = 0x80, hi = 0xBF;
+		if ( c >= 0xC2 && c <= 0xDF )
+			len = 2;
+		else if ( c >= 0xE0 && c <= 0xEF ) {
+			len = 3;
+			if ( c == 0xE0 )
+				lo = 0xA0;
+			else if ( c == 0xED )
+				hi = 0x9F;
+		}
+		else if ( c >= 0xF0 && c <= 0xF4 ) {
+			len = 4;
+			if ( c == 0xF0 )
+				lo = 0x90;
+			else if ( c == 0xF4 )
+				hi = 0x8F;
+		}
+		else
+			return i;
+
+		if ( size - i < len || s[i + 1] < lo || s[i + 1] > hi )
+			return i;
+		for (std::size_t k = 2; k < len; ++k)
+			if ( (s[i + k] & 0xC0) != 0x80 )
+				return i;
+		i += len;
+	}
+	return size;
+}
+
+} // namespace safe_detail
+
+
+// character sets; first_invalid() returns the size when every character is valid
+template <unsigned char... bounds>
+struct char_ranges {
+	typedef safe_detail::range_set<bounds...> ranges;
+
+	static char const* name() { return "in the character set"; }
+	static bool contains(unsigned char c) { return ranges::contains(c); }
+	static std::size_t first_invalid(char const* str, std::size_t size)
+	{ return safe_detail::first_not_in<ranges>(str, size); }
+};
+
+struct ascii : char_ranges<0x00, 0x7F> {
+	static char const* name() { return "ASCII"; }
+	static std::size_t first_invalid(char const* str, std::size_t size)
+	{
+		std::size_t const i = safe_detail::ascii_prefix(str, size);
+		return i + safe_detail::first_not_in<ranges>(str + i, size - i);
+	}
+};
+
+struct printable : char_ranges<0x20, 0x7E> {
+	static char const* name() { return "printable ASCII"; }
+};
+
+struct alnum : char_ranges<'0', '9', 'A', 'Z', 'a', 'z'> {
+	static char const* name() { return "alphanumeric"; }
+};
+
+struct digit : char_ranges<'0', '9'> {
+	static char const* name() { return "a digit"; }
+};
+
+struct xdigit : char_ranges<'0', '9', 'A', 'F', 'a', 'f'> {
+	static char const* name() { return "a hex digit"; }
+};
+
+struct utf8 {
+	static char const* name() { return "valid UTF-8"; }
+	static std::size_t first_invalid(char const* str, std::size_t size)
+	{ return safe_detail::first_not_utf8(str, size); }
+};
+
+
+template <class T, class charset>
+struct charset_exception : public std::invalid_argument {
+	typedef std::invalid_argument base;
+	typedef T value_type;
+	typedef typename safe_detail::types<T>::argument_type argument_type;
+
+	charset_exception(argument_type data, std::size_t offset) :
+		base(charset_msg(data, offset)),
+		offset_(offset)
+	{ }
+
+	// offset of the first invalid byte
+	std::size_t offset() const { return offset_; }
+
+	static std::string charset_msg(argument_type data, std::size_t offset)
+	{
+		std::ostringstream ss;
+		ss  << "The value \"";
+		safe_detail::write_prefix(ss, data, 32);
+		ss  << "\" has a character at offset " << offset
+			<< " that is not " << charset::name() << '.';
+		return ss.str();
+	}
+
+private:
+	std::size_t offset_;
+};
+
+
+// charset validations for strings and string views
+template <class T, class charset, class exception = charset_exception<T, charset> >
+struct charset_validation {
+	typedef charset charset_type;
+	typedef exception exception_type;
+	typedef typename safe_detail::types<T>::argument_type argument_type;
+
+	static inline std::size_t first_invalid(argument_type str)
+	{ return charset::first_invalid(str.data(), str.size()); }
+	static inline bool is_valid(argument_type str)
+	{ return first_invalid(str) == str.size(); }
+	static inline void validate(argument_type str)
+	{
+		std::size_t const offset = first_invalid(str);
+		if ( offset != str.size() )
+			throw exception_type(str, offset);
+	}
+};
+
+template <class T, class exception = charset_exception<T, ascii> >
+struct ascii_validation : charset_validation<T, ascii, exception> { };
+
+template <class T, class exception = charset_exception<T, utf8> >
+struct utf8_validation : charset_validation<T, utf8, exception> { };
+
+// str_length_validation and charset_validation in one scan of the string;
+// validate() throws length_exception_type as well as exception_type
+template <class T, class length, class charset,
+	class length_exception = str_length_exception<T, length>,
+	class exception = charset_exception<T, charset> >
+struct str_length_charset_validation {
+	typedef length value;
+	typedef charset charset_type;
+	typedef length_exception length_exception_type;
+	typedef exception exception_type;
+	typedef typename safe_detail::types<T>::argument_type argument_type;
+
+	static inline bool is_valid(argument_type str)
+	{
+		return !( str.length() > value() )
+			&& charset::first_invalid(str.data(), str.size()) == str.size();
+	}
+	static inline void validate(argument_type str)
+	{
+		if ( str.length() > value() )
+			throw length_exception_type(str, str.length());
+		std::size_t const offset = charset::first_invalid(str.data(), str.size());
+		if ( offset != str.size() )
+			throw exception_type(str, offset);
+	}
+};
+
+} // namespace safe_data
+
+#endif
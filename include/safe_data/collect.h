@@ -0,0 +1,283 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/collect.h
+
+Created: 2026.10.18
+
+Description:
+	Collecting validation for batch ingest. Instead of throwing on the first
+	bad value, check() and try_assign() record each violation in a
+	violation_sink and carry on. A violation records its kind, the value (or
+	size/length), the bounds, and the row and column it came from.
+
+	The sink's storage is allocated once, up front. After that, recording a
+	violation never allocates or throws. Once the sink is full, further
+	violations are only counted. Validations that provide is_valid() are
+	checked without exceptions; any others fall back to catching the
+	exception from validate().
+*/
+
+#ifndef SAFE_DATA_COLLECT_MPN_18OCT2026_HPP
+#define SAFE_DATA_COLLECT_MPN_18OCT2026_HPP
+
+#include "safe_data/safe.h"
+#include "safe_data/validations.h"
+
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace safe_data {
+
+// see charset.h; declared here so this header does not depend on it
+template <class T, class length, class charset, class length_exception, class exception>
+struct str_length_charset_validation;
+
+enum violation_kind {
+	min_violation,
+	max_violation,
+	range_violation,
+	size_violation,
+	length_violation,
+	other_violation,
+	violation_kinds
+};
+
+struct violation {
+	violation_kind kind;
+	std::size_t    row;
+	std::size_t    column;
+	double         value;  // size or length for containers and strings
+	double         lower;  // NaN when unbounded
+	double         upper;
+};
+
+class violation_sink {
+public:
+	explicit violation_sink(std::size_t capacity) : total_(0)
+	{
+		entries_.reserve(capacity);
+		clear();
+	}
+
+	void record(violation const& v)
+	{
+		++total_;
+		++counts_[v.kind];
+		if ( entries_.size() < entries_.capacity() )
+			entries_.push_back(v);
+	}
+
+	void clear()
+	{
+		entries_.clear();
+		total_ = 0;
+		for (int k = 0; k < violation_kinds; ++k)
+			counts_[k] = 0;
+	}
+
+	bool        empty()    const { return total_ == 0; }
+	std::size_t total()    const { return total_; }
+	std::size_t stored()   const { return entries_.size(); }
+	std::size_t dropped()  const { return total_ - entries_.size(); }
+	std::size_t capacity() const { return entries_.capacity(); }
+	std::size_t count(violation_kind kind) const { return counts_[kind]; }
+
+	typedef std::vector<violation>::const_iterator const_iterator;
+	const_iterator begin() const { return entries_.begin(); }
+	const_iterator end()   const { return entries_.end(); }
+	violation const& operator[] (std::size_t i) const { return entries_[i]; }
+
+	// summary by kind followed by the first max_listed violations
+	void report(std::ostream& out, std::size_t max_listed = 10) const
+	{
+		static char const* const names[violation_kinds] = {
+			"min", "max", "range", "size", "length", "other"
+		};
+
+		out << total_ << " violation(s)";
+		if ( dropped() )
+			out << " (" << dropped() << " not stored)";
+		for (int k = 0; k < violation_kinds; ++k)
+			if ( counts_[k] )
+				out << ", " << names[k] << ' ' << counts_[k];
+		out << '\n';
+
+		for (std::size_t i = 0; i < entries_.size() && i < max_listed; ++i) {
+			violation const& v = entries_[i];
+			out << "  row " << v.row << " column " << v.column << ": "
+				<< names[v.kind] << ' ' << v.value;
+			if ( v.lower == v.lower || v.upper == v.upper )
+				out << " not in [" << v.lower << ", " << v.upper << ']';
+			out << '\n';
+		}
+	}
+
+private:
+	std::vector<violation> entries_;
+	std::size_t            total_;
+	std::size_t            counts_[violation_kinds];
+};
+
+
+namespace safe_detail {
+
+inline double no_bound() { return std::numeric_limits<double>::quiet_NaN(); }
+
+template <class T>
+inline typename std::enable_if<std::is_arithmetic<T>::value, double>::type
+	as_number(T const& data) { return static_cast<double>(data); }
+
+template <class T>
+inline typename std::enable_if<!std::is_arithmetic<T>::value, double>::type
+	as_number(T const&) { return no_bound(); }
+
+template <class B>
+inline double bound() { return static_cast<double>(B()); }
+
+// fills in the kind, value and bounds of a failed validation
+template <class V>
+struct violation_traits {
+	template <class A>
+	static void describe(A const& data, violation& v)
+	{
+		v.kind = other_violation;
+		v.value = as_number(data);
+	}
+};
+
+template <violation_kind kind>
+struct describe_bounds {
+	template <class A, class L, class U>
+	static void apply(A const& data, violation& v, L lower, U upper)
+	{
+		v.kind = kind;
+		v.value = as_number(data);
+		v.lower = lower;
+		v.upper = upper;
+	}
+};
+
+#define SAFE_DATA_MIN_VIOLATION(validation)                                     \
+	template <class T, class M, class E>                                        \
+	struct violation_traits<validation<T, M, E> > {                             \
+		template <class A>                                                      \
+		static void describe(A const& data, violation& v)                       \
+		{ describe_bounds<min_violation>::apply(data, v, bound<M>(), no_bound()); } \
+	};
+
+#define SAFE_DATA_MAX_VIOLATION(validation)                                     \
+	template <class T, class M, class E>                                        \
+	struct violation_traits<validation<T, M, E> > {                             \
+		template <class A>                                                      \
+		static void describe(A const& data, violation& v)                       \
+		{ describe_bounds<max_violation>::apply(data, v, no_bound(), bound<M>()); } \
+	};
+
+#define SAFE_DATA_RANGE_VIOLATION(validation)                                   \
+	template <class T, class L, class U, class E>                               \
+	struct violation_traits<validation<T, L, U, E> > {                          \
+		template <class A>                                                      \
+		static void describe(A const& data, violation& v)                       \
+		{ describe_bounds<range_violation>::apply(data, v, bound<L>(), bound<U>()); } \
+	};
+
+SAFE_DATA_MIN_VIOLATION(min_validation)
+SAFE_DATA_MIN_VIOLATION(min_validation_lte)
+SAFE_DATA_MAX_VIOLATION(max_validation)
+SAFE_DATA_MAX_VIOLATION(max_validation_gte)
+SAFE_DATA_RANGE_VIOLATION(range_validation)
+SAFE_DATA_RANGE_VIOLATION(range_validation_min_lte_max_gte)
+SAFE_DATA_RANGE_VIOLATION(range_validation_min_lte)
+SAFE_DATA_RANGE_VIOLATION(range_validation_max_gte)
+
+#undef SAFE_DATA_MIN_VIOLATION
+#undef SAFE_DATA_MAX_VIOLATION
+#undef SAFE_DATA_RANGE_VIOLATION
+
+template <class T, class S, class E>
+struct violation_traits<size_validation<T, S, E> > {
+	template <class A>
+	static void describe(A const& data, violation& v)
+	{ describe_bounds<size_violation>::apply(data.size(), v, no_bound(), bound<S>()); }
+};
+
+template <class T, class L, class E>
+struct violation_traits<str_length_validation<T, L, E> > {
+	template <class A>
+	static void describe(A const& data, violation& v)
+	{ describe_bounds<length_violation>::apply(data.length(), v, no_bound(), bound<L>()); }
+};
+
+// reports the length failure as a length violation and a bad character as other
+template <class T, class L, class C, class LE, class E>
+struct violation_traits<str_length_charset_validation<T, L, C, LE, E> > {
+	template <class A>
+	static void describe(A const& data, violation& v)
+	{
+		if ( data.length() > L() ) {
+			describe_bounds<length_violation>::apply(data.length(), v, no_bound(), bound<L>());
+		}
+		else {
+			v.kind = other_violation;
+			v.value = no_bound();
+		}
+	}
+};
+
+template <class V, class A>
+inline bool is_valid(A const& data, std::true_type) { return V::is_valid(data); }
+
+template <class V, class A>
+inline bool is_valid(A const& data, std::false_type)
+{
+	try {
+		V::validate(data);
+		return true;
+	}
+	catch (std::exception const&) {
+		return false;
+	}
+}
+
+} // namespace safe_detail
+
+
+// validates data without throwing; records a violation when it fails
+template <class validation, class A>
+inline bool check(A const& data, violation_sink& sink, std::size_t row = 0, std::size_t column = 0)
+{
+	if ( safe_detail::is_valid<validation>(data,
+			std::integral_constant<bool, safe_detail::has_is_valid<validation, A>::value>()) )
+		return true;
+
+	violation v;
+	v.row = row;
+	v.column = column;
+	v.lower = v.upper = safe_detail::no_bound();
+	safe_detail::violation_traits<validation>::describe(data, v);
+	sink.record(v);
+	return false;
+}
+
+// assigns data when it is valid, otherwise records the violation and keeps s unchanged
+template <class T, class V, class I, class U>
+inline bool try_assign(safe<T,V,I>& s, U const& data, violation_sink& sink,
+	std::size_t row = 0, std::size_t column = 0)
+{
+	typename safe<T,V,I>::raw_type value(data);
+	if ( !check<V>(value, sink, row, column) )
+		return false;
+	safe<T,V,I>(unchecked, std::move(value)).swap(s); // value is moved, never copied again
+	return true;
+}
+
+} // namespace safe_data
+
+#endif
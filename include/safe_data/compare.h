@@ -15,6 +15,7 @@ Description:
 #define SAFE_DATA_COMPARE_MPN_14MAY2006_HPP
 
 #include "safe_data/safe_fwd.h"
+#include "safe_data/safe_detail.h"
 
 namespace safe_data {
 
@@ -25,11 +26,13 @@ inline bool operator== (safe<T,V,I> const& lhs, safe<T2,V2,I2> const& rhs)
 { return lhs.data() == rhs.data(); }
 
 template <class T, class V, class I, class Y>
-inline bool operator== (safe<T,V,I> const& lhs, Y const& rhs)
+inline auto operator== (safe<T,V,I> const& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, bool, decltype(lhs.data() == rhs)>::type
 { return lhs.data() == rhs; }
 
 template <class T, class V, class I, class Y>
-inline bool operator== (Y const& lhs, safe<T,V,I> const& rhs)
+inline auto operator== (Y const& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, bool, decltype(rhs.data() == lhs)>::type
 { return rhs.data() == lhs; }
 
 
@@ -39,11 +42,13 @@ inline bool operator< (safe<T,V,I> const& lhs, safe<T2,V2,I2> const& rhs)
 { return lhs.data() < rhs.data(); }
 
 template <class T, class V, class I, class Y>
-inline bool operator< (safe<T,V,I> const& lhs, Y const& rhs)
+inline auto operator< (safe<T,V,I> const& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, bool, decltype(lhs.data() < rhs)>::type
 { return lhs.data() < rhs; }
 
 template <class T, class V, class I, class Y>
-inline bool operator< (Y const& lhs, safe<T,V,I> const& rhs)
+inline auto operator< (Y const& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, bool, decltype(lhs < rhs.data())>::type
 { return lhs < rhs.data(); }
 
 
@@ -53,11 +58,13 @@ inline bool operator!= (safe<T,V,I> const& lhs, safe<T2,V2,I2> const& rhs)
 { return !(lhs == rhs); }
 
 template <class T, class V, class I, class Y>
-inline bool operator!= (safe<T,V,I> const& lhs, Y const& rhs)
+inline auto operator!= (safe<T,V,I> const& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, bool, decltype(lhs.data() == rhs)>::type
 { return !(lhs == rhs); }
 
 template <class T, class V, class I, class Y>
-inline bool operator!= (Y const& lhs, safe<T,V,I> const& rhs)
+inline auto operator!= (Y const& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, bool, decltype(rhs.data() == lhs)>::type
 { return !(lhs == rhs); }
 
 
@@ -67,11 +74,13 @@ inline bool operator> (safe<T,V,I> const& lhs, safe<T2,V2,I2> const& rhs)
 { return rhs < lhs; }
 
 template <class T, class V, class I, class Y>
-inline bool operator> (safe<T,V,I> const& lhs, Y const& rhs)
+inline auto operator> (safe<T,V,I> const& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, bool, decltype(rhs < lhs.data())>::type
 { return rhs < lhs; }
 
 template <class T, class V, class I, class Y>
-inline bool operator> (Y const& lhs, safe<T,V,I> const& rhs)
+inline auto operator> (Y const& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, bool, decltype(rhs.data() < lhs)>::type
 { return rhs < lhs; }
 
 
@@ -81,26 +90,30 @@ inline bool operator<= (safe<T,V,I> const& lhs, safe<T2,V2,I2> const& rhs)
 { return !(rhs < lhs); }
 
 template <class T, class V, class I, class Y>
-inline bool operator<= (safe<T,V,I> const& lhs, Y const& rhs)
+inline auto operator<= (safe<T,V,I> const& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, bool, decltype(rhs < lhs.data())>::type
 { return !(rhs < lhs); }
 
 template <class T, class V, class I, class Y>
-inline bool operator<= (Y const& lhs, safe<T,V,I> const& rhs)
+inline auto operator<= (Y const& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, bool, decltype(rhs.data() < lhs)>::type
 { return !(rhs < lhs); }
 
 
 // >=
 template <class T, class V, class I, class T2, class V2, class I2>
 inline bool operator>= (safe<T,V,I> const& lhs, safe<T2,V2,I2> const& rhs)
-{ return (!lhs < rhs); }
+{ return !(lhs < rhs); }
 
 template <class T, class V, class I, class Y>
-inline bool operator>= (safe<T,V,I> const& lhs, Y const& rhs)
-{ return (!lhs < rhs); }
+inline auto operator>= (safe<T,V,I> const& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, bool, decltype(lhs.data() < rhs)>::type
+{ return !(lhs < rhs); }
 
 template <class T, class V, class I, class Y>
-inline bool operator>= (Y const& lhs, safe<T,V,I> const& rhs)
-{ return (!lhs < rhs); }
+inline auto operator>= (Y const& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, bool, decltype(lhs < rhs.data())>::type
+{ return !(lhs < rhs); }
 
 
 } // namespace safe_data
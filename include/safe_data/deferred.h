@@ -0,0 +1,78 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/deferred.h
+
+Created: 2026.10.18
+
+Description:
+	Deferred validation for safe<>. An edit handle works on a raw copy of the
+	data, so intermediate steps are not validated. The result is validated
+	once on commit(). A failed commit leaves the safe<> holding its prior
+	valid value, and an edit that is never committed is discarded.
+
+		safe_int i;
+		deferred_validation<safe_int> e = edit(i);
+		for (int n = 0; n < 1000; ++n)
+			++*e;
+		e.commit();
+*/
+
+#ifndef SAFE_DATA_DEFERRED_MPN_18OCT2026_HPP
+#define SAFE_DATA_DEFERRED_MPN_18OCT2026_HPP
+
+#include "safe_data/safe_fwd.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace safe_data {
+
+template <class Safe>
+class deferred_validation {
+	deferred_validation(deferred_validation const&);
+	deferred_validation& operator= (deferred_validation const&);
+public:
+	typedef Safe                    safe_type;
+	typedef typename Safe::raw_type raw_type;
+
+	explicit deferred_validation(safe_type& target) :
+		target_(&target), value_(target.data()), active_(true)
+	{ }
+	deferred_validation(deferred_validation&& other) :
+		target_(other.target_), value_(std::move(other.value_)), active_(other.active_)
+	{ other.active_ = false; }
+
+// unvalidated access to the working copy
+	raw_type& operator* ()  { return value_; }
+	raw_type* operator-> () { return &value_; }
+	raw_type&       get()       { return value_; }
+	raw_type const& get() const { return value_; }
+
+	bool active() const { return active_; }
+
+// validates once; the edit stays active when validation fails
+	void commit()
+	{
+		if ( !active_ )
+			throw std::logic_error("deferred_validation already committed or cancelled");
+		*target_ = value_;
+		active_ = false;
+	}
+
+	void cancel() { active_ = false; }
+
+private:
+	safe_type* target_;
+	raw_type   value_;
+	bool       active_;
+};
+
+template <class T, class V, class I>
+inline deferred_validation<safe<T,V,I> > edit(safe<T,V,I>& s)
+{ return deferred_validation<safe<T,V,I> >(s); }
+
+} // namespace safe_data
+
+#endif
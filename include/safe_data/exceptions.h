@@ -15,11 +15,28 @@ Description:
 
 #include "safe_data/safe_detail.h"
 
+#include <cstddef>
 #include <stdexcept>
 #include <string>
 #include <sstream>
+#include <vector>
 
 namespace safe_data {
+namespace safe_detail {
+
+// streams at most max characters of a string, marking a cut with "..."
+template <class S>
+void write_prefix(std::ostream& out, S const& str, std::size_t max)
+{
+	if ( str.size() <= max ) {
+		out.write(str.data(), str.size());
+		return;
+	}
+	out.write(str.data(), max);
+	out << "...";
+}
+
+} // namespace safe_detail
 
 
 template <class T, class min_value>
@@ -97,9 +114,13 @@ struct size_exception : public std::length_error {
 	explicit size_exception(std::string const& msg) : base(msg) { }
 
 	static std::string size_msg(argument_type data)
+	{
+		return size_msg(data.size());
+	}
+	static std::string size_msg(std::size_t n)
 	{
 		std::ostringstream ss;
-		ss  << "The size " << data.size()
+		ss  << "The size " << n
 			<< " must not exceed "
 			<< value()
 			<< '.';
@@ -116,17 +137,29 @@ struct str_length_exception : public std::length_error {
 	typedef typename safe_detail::types<T> types;
 	typedef typename types::argument_type argument_type;
 	typedef typename types::raw_type             raw_type;
-	typedef typename raw_type::size_type     length_type;
+	typedef std::size_t                          length_type;
+
+	static length_type const quoted_length = 32;
 
 	str_length_exception(argument_type data, length_type const& len) :
 		base(length_msg(data, len))
 	{ }
 	explicit str_length_exception(std::string const& msg) : base(msg) { }
 
-	static std::string length_msg(argument_type data, length_type const& )
+	static std::string length_msg(argument_type data, length_type const& len)
+	{
+		std::ostringstream ss;
+		ss  << "The length " << len << " of \"";
+		safe_detail::write_prefix(ss, data, quoted_length);
+		ss  << "\" must not exceed "
+			<< value()
+			<< '.';
+		return ss.str();
+	}
+	static std::string length_msg(std::size_t len)
 	{
 		std::ostringstream ss;
-		ss  << "The length of " << data
+		ss  << "The length " << len
 			<< " must not exceed "
 			<< value()
 			<< '.';
@@ -135,6 +168,32 @@ struct str_length_exception : public std::length_error {
 };
 
 
+// thrown when validating many elements at once; holds the failing positions
+struct element_exception : public std::invalid_argument {
+	typedef std::invalid_argument base;
+	typedef std::vector<std::size_t> positions_type;
+
+	element_exception(positions_type const& positions, std::string const& first_msg) :
+		base(element_msg(positions, first_msg)),
+		positions_(positions)
+	{ }
+
+	positions_type const& positions() const { return positions_; }
+
+	static std::string element_msg(positions_type const& positions, std::string const& first_msg)
+	{
+		std::ostringstream ss;
+		ss  << positions.size() << " element(s) failed validation";
+		if ( !positions.empty() )
+			ss << ", first at position " << positions.front() << ": " << first_msg;
+		return ss.str();
+	}
+
+private:
+	positions_type positions_;
+};
+
+
 } // namespace safe_data
 
 #endif
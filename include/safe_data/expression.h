@@ -0,0 +1,281 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/expression.h
+
+Created: 2026.10.18
+
+Description:
+	Lazy arithmetic and bitwise expressions over safe<>. The operators in
+	operators.h build and validate a temporary safe<> at every step, so
+	an intermediate result can throw even when the final one is valid.
+	An expression started with lazy() is instead evaluated in the raw
+	types and validated once, when it is assigned to a safe<>:
+
+		score total = lazy(a) + lazy(b) * c - d;
+
+	Each operator needs an expression on at least one side; b * c alone
+	still uses the eager operator. The operands are held by reference
+	until the assignment.
+
+	The range of an integral expression is computed at compile time from
+	the static bounds of its operands. When that range is inside the
+	bounds of the target, the validation is skipped.
+*/
+
+#ifndef SAFE_DATA_EXPRESSION_MPN_18OCT2026_HPP
+#define SAFE_DATA_EXPRESSION_MPN_18OCT2026_HPP
+
+#include "safe_data/safe.h"
+#include "safe_data/validations.h"
+
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace safe_data {
+namespace safe_detail {
+
+// integers below 2^53 are exact in a double
+constexpr bool exact(double d) { return d > -9007199254740992.0 && d < 9007199254740992.0; }
+
+constexpr double min2(double a, double b) { return a < b ? a : b; }
+constexpr double max2(double a, double b) { return a < b ? b : a; }
+
+template <class T, bool = std::is_integral<T>::value>
+struct fits_type {
+	static constexpr bool apply(double, double) { return false; }
+};
+
+template <class T>
+struct fits_type<T, true> {
+	static constexpr bool apply(double lower, double upper)
+	{
+		return exact(lower) && exact(upper)
+			&& lower >= static_cast<double>(std::numeric_limits<T>::lowest())
+			&& upper <= static_cast<double>(std::numeric_limits<T>::max());
+	}
+};
+
+// range of a leaf: the static bounds of its validation, else the limits of an integral type
+template <class T, class V, bool = static_bounds<V>::known, bool = std::is_integral<T>::value>
+struct leaf_bounds {
+	static bool const bounded = false;
+	static constexpr double lower = 0;
+	static constexpr double upper = 0;
+};
+
+template <class T, class V, bool integral>
+struct leaf_bounds<T, V, true, integral> {
+	static bool const bounded = integral;
+	static constexpr double lower = static_bounds<V>::lower;
+	static constexpr double upper = static_bounds<V>::upper;
+};
+
+template <class T, class V>
+struct leaf_bounds<T, V, false, true> {
+	static bool const bounded = fits_type<T>::apply(
+		static_cast<double>(std::numeric_limits<T>::lowest()),
+		static_cast<double>(std::numeric_limits<T>::max()));
+	static constexpr double lower = static_cast<double>(std::numeric_limits<T>::lowest());
+	static constexpr double upper = static_cast<double>(std::numeric_limits<T>::max());
+};
+
+// a safe<> operand, held by reference, or a raw one, held by value
+template <class T, class V, class Stored>
+struct leaf : leaf_bounds<T, V> {
+	typedef T value_type;
+
+	explicit leaf(Stored value) : value_(value) { }
+	T const& eval() const { return value_; }
+
+private:
+	Stored value_;
+};
+
+// operators; ranged ones also map operand ranges to a result range
+#define SAFE_DATA_LAZY_OP(name, op)                                             \
+	struct name {                                                               \
+		static bool const ranged = false;                                       \
+		template <class A, class B>                                             \
+		static auto apply(A const& a, B const& b) -> decltype(a op b) { return a op b; } \
+		static constexpr double lower(double, double, double, double) { return 0; } \
+		static constexpr double upper(double, double, double, double) { return 0; } \
+	};
+
+SAFE_DATA_LAZY_OP(divides_op, /)
+SAFE_DATA_LAZY_OP(modulus_op, %)
+SAFE_DATA_LAZY_OP(bit_and_op, &)
+SAFE_DATA_LAZY_OP(bit_or_op,  |)
+SAFE_DATA_LAZY_OP(bit_xor_op, ^)
+SAFE_DATA_LAZY_OP(shift_left_op, <<)
+SAFE_DATA_LAZY_OP(shift_right_op, >>)
+
+#undef SAFE_DATA_LAZY_OP
+
+struct plus_op {
+	static bool const ranged = true;
+	template <class A, class B>
+	static auto apply(A const& a, B const& b) -> decltype(a + b) { return a + b; }
+	static constexpr double lower(double al, double, double bl, double) { return al + bl; }
+	static constexpr double upper(double, double ah, double, double bh) { return ah + bh; }
+};
+
+struct minus_op {
+	static bool const ranged = true;
+	template <class A, class B>
+	static auto apply(A const& a, B const& b) -> decltype(a - b) { return a - b; }
+	static constexpr double lower(double al, double, double, double bh) { return al - bh; }
+	static constexpr double upper(double, double ah, double bl, double) { return ah - bl; }
+};
+
+struct multiplies_op {
+	static bool const ranged = true;
+	template <class A, class B>
+	static auto apply(A const& a, B const& b) -> decltype(a * b) { return a * b; }
+	static constexpr double lower(double al, double ah, double bl, double bh)
+	{ return min2(min2(al * bl, al * bh), min2(ah * bl, ah * bh)); }
+	static constexpr double upper(double al, double ah, double bl, double bh)
+	{ return max2(max2(al * bl, al * bh), max2(ah * bl, ah * bh)); }
+};
+
+template <class Op, class L, class R>
+struct binary {
+	typedef decltype(Op::apply(std::declval<typename L::value_type>(),
+		std::declval<typename R::value_type>())) value_type;
+
+	static constexpr double lower = Op::lower(L::lower, L::upper, R::lower, R::upper);
+	static constexpr double upper = Op::upper(L::lower, L::upper, R::lower, R::upper);
+	static bool const bounded = Op::ranged && L::bounded && R::bounded
+		&& fits_type<value_type>::apply(lower, upper);
+
+	binary(L const& lhs, R const& rhs) : lhs_(lhs), rhs_(rhs) { }
+	value_type eval() const { return Op::apply(lhs_.eval(), rhs_.eval()); }
+
+private:
+	L lhs_;
+	R rhs_;
+};
+
+// true when every value in the range of E is accepted by V
+template <class E, class V, bool = E::bounded && static_bounds<V>::known>
+struct always_valid : std::false_type { };
+
+template <class E, class V>
+struct always_valid<E, V, true> : std::integral_constant<bool,
+	(E::lower >= static_bounds<V>::lower && E::upper <= static_bounds<V>::upper)> { };
+
+} // namespace safe_detail
+
+
+template <class E>
+class expression {
+public:
+	typedef E                         node_type;
+	typedef typename E::value_type    value_type;
+
+	explicit expression(E const& node) : node_(node) { }
+
+	node_type const& node() const { return node_; }
+	value_type       eval() const { return node_.eval(); }
+
+	// the value for Safe, validated unless its range already fits
+	template <class Safe>
+	typename Safe::raw_type assign_to() const
+	{
+		typedef typename Safe::validation_type validation;
+		typename Safe::raw_type result(node_.eval());
+		check<validation>(result, safe_detail::always_valid<E, validation>());
+		return result;
+	}
+
+private:
+	template <class V, class R>
+	static void check(R const& result, std::false_type) { V::validate(result); }
+	template <class V, class R>
+	static void check(R const&, std::true_type) { }
+
+	E node_;
+};
+
+template <class T, class V, class I>
+inline expression<safe_detail::leaf<typename safe<T,V,I>::raw_type, V, typename safe<T,V,I>::reference_const_type> >
+	lazy(safe<T,V,I> const& s)
+{
+	typedef safe_detail::leaf<typename safe<T,V,I>::raw_type, V, typename safe<T,V,I>::reference_const_type> leaf_type;
+	return expression<leaf_type>(leaf_type(s.data()));
+}
+
+namespace safe_detail {
+
+template <class T, class V, class I>
+inline leaf<typename safe<T,V,I>::raw_type, V, typename safe<T,V,I>::reference_const_type>
+	operand(safe<T,V,I> const& s)
+{ return leaf<typename safe<T,V,I>::raw_type, V, typename safe<T,V,I>::reference_const_type>(s.data()); }
+
+template <class E>
+inline E const& operand(expression<E> const& e) { return e.node(); }
+
+template <class Y>
+inline leaf<Y, no_validation<Y>, Y> operand(Y const& y) { return leaf<Y, no_validation<Y>, Y>(y); }
+
+template <class Op, class A, class B>
+struct make_binary {
+	typedef binary<Op,
+		typename std::decay<decltype(operand(std::declval<A const&>()))>::type,
+		typename std::decay<decltype(operand(std::declval<B const&>()))>::type> node_type;
+	typedef expression<node_type> type;
+
+	static type apply(A const& a, B const& b) { return type(node_type(operand(a), operand(b))); }
+};
+
+} // namespace safe_detail
+
+
+#define SAFE_DATA_LAZY_OPERATOR(op, name)                                       \
+	template <class E1, class E2>                                               \
+	inline typename safe_detail::make_binary<safe_detail::name, expression<E1>, expression<E2> >::type \
+		operator op (expression<E1> const& lhs, expression<E2> const& rhs)      \
+	{ return safe_detail::make_binary<safe_detail::name, expression<E1>, expression<E2> >::apply(lhs, rhs); } \
+                                                                                \
+	template <class E, class T, class V, class I>                               \
+	inline typename safe_detail::make_binary<safe_detail::name, expression<E>, safe<T,V,I> >::type \
+		operator op (expression<E> const& lhs, safe<T,V,I> const& rhs)          \
+	{ return safe_detail::make_binary<safe_detail::name, expression<E>, safe<T,V,I> >::apply(lhs, rhs); } \
+                                                                                \
+	template <class T, class V, class I, class E>                               \
+	inline typename safe_detail::make_binary<safe_detail::name, safe<T,V,I>, expression<E> >::type \
+		operator op (safe<T,V,I> const& lhs, expression<E> const& rhs)          \
+	{ return safe_detail::make_binary<safe_detail::name, safe<T,V,I>, expression<E> >::apply(lhs, rhs); } \
+                                                                                \
+	template <class E, class Y>                                                 \
+	inline typename safe_detail::make_binary<safe_detail::name, expression<E>, Y>::type \
+		operator op (expression<E> const& lhs, Y const& rhs)                    \
+	{ return safe_detail::make_binary<safe_detail::name, expression<E>, Y>::apply(lhs, rhs); } \
+                                                                                \
+	template <class Y, class E>                                                 \
+	inline typename safe_detail::make_binary<safe_detail::name, Y, expression<E> >::type \
+		operator op (Y const& lhs, expression<E> const& rhs)                    \
+	{ return safe_detail::make_binary<safe_detail::name, Y, expression<E> >::apply(lhs, rhs); } \
+                                                                                \
+	template <class T, class V, class I, class E>                               \
+	inline safe<T,V,I>& operator op##= (safe<T,V,I>& lhs, expression<E> const& rhs) \
+	{ lhs = lazy(lhs) op rhs; return lhs; }
+
+SAFE_DATA_LAZY_OPERATOR(+,  plus_op)
+SAFE_DATA_LAZY_OPERATOR(-,  minus_op)
+SAFE_DATA_LAZY_OPERATOR(*,  multiplies_op)
+SAFE_DATA_LAZY_OPERATOR(/,  divides_op)
+SAFE_DATA_LAZY_OPERATOR(%,  modulus_op)
+SAFE_DATA_LAZY_OPERATOR(&,  bit_and_op)
+SAFE_DATA_LAZY_OPERATOR(|,  bit_or_op)
+SAFE_DATA_LAZY_OPERATOR(^,  bit_xor_op)
+SAFE_DATA_LAZY_OPERATOR(<<, shift_left_op)
+SAFE_DATA_LAZY_OPERATOR(>>, shift_right_op)
+
+#undef SAFE_DATA_LAZY_OPERATOR
+
+} // namespace safe_data
+
+#endif
@@ -0,0 +1,105 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/hash.h
+
+Created: 2026.10.18
+
+Description:
+	Hashing and transparent comparison for safe<> keys. std::hash is
+	specialized for safe<>, so safe<> keys work in unordered containers
+	as is. safe_hash, safe_equal and safe_less also accept the raw type
+	and are transparent. Lookups with a raw key therefore skip the
+	temporary safe<>, its copy and its validation:
+
+		std::unordered_map<safe_name, int, safe_hash, safe_equal> ids;
+		ids.find(std::string_view("alice"));
+
+		std::map<safe_name, int, safe_less> ranks;
+		ranks.find("alice");
+
+	Strings hash the same as their std::string_view, so a std::string key
+	can be looked up with a view or a string literal. Heterogeneous lookup
+	needs C++14 for ordered containers and C++20 for unordered ones; the
+	string_view hashing needs C++17.
+*/
+
+#ifndef SAFE_DATA_HASH_MPN_18OCT2026_HPP
+#define SAFE_DATA_HASH_MPN_18OCT2026_HPP
+
+#include "safe_data/safe.h"
+#include "safe_data/compare.h"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+namespace safe_data {
+namespace safe_detail {
+
+// the wrapped value of a safe<>, or the key itself
+template <class T, class V, class I>
+inline typename safe<T,V,I>::reference_const_type raw_key(safe<T,V,I> const& key) { return key.data(); }
+
+template <class K>
+inline K const& raw_key(K const& key) { return key; }
+
+template <class K>
+inline std::size_t hash_key(K const& key) { return std::hash<K>()(key); }
+
+#if __cplusplus >= 201703L
+template <class C, class Tr, class A>
+inline std::size_t hash_key(std::basic_string<C,Tr,A> const& key)
+{ return std::hash<std::basic_string_view<C,Tr> >()(key); }
+
+inline std::size_t hash_key(char const* key) { return std::hash<std::string_view>()(key); }
+#endif
+
+} // namespace safe_detail
+
+
+struct safe_hash {
+	typedef void is_transparent;
+
+	template <class K>
+	std::size_t operator() (K const& key) const
+	{ return safe_detail::hash_key(safe_detail::raw_key(key)); }
+};
+
+struct safe_equal {
+	typedef void is_transparent;
+
+	template <class A, class B>
+	bool operator() (A const& lhs, B const& rhs) const
+	{ return safe_detail::raw_key(lhs) == safe_detail::raw_key(rhs); }
+};
+
+struct safe_less {
+	typedef void is_transparent;
+
+	template <class A, class B>
+	bool operator() (A const& lhs, B const& rhs) const
+	{ return safe_detail::raw_key(lhs) < safe_detail::raw_key(rhs); }
+};
+
+} // namespace safe_data
+
+
+namespace std {
+
+template <class T, class V, class I>
+struct hash<safe_data::safe<T,V,I> > {
+	typedef safe_data::safe<T,V,I> argument_type;
+	typedef std::size_t            result_type;
+
+	std::size_t operator() (argument_type const& key) const { return safe_data::safe_hash()(key); }
+};
+
+} // namespace std
+
+#endif
@@ -0,0 +1,309 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/index.h
+
+Created: 2026.10.18
+
+Description:
+	Dense maps and sets keyed by safe<> integers with static bounds, such as
+	port numbers, small ids and enumerated codes. The validation proves a
+	key is inside [lower, upper], so a key indexes an array directly, with
+	no hashing.
+
+	The key's initial value must be a compile-time constant inside the
+	bounds, since a default-constructed key is not validated when NDEBUG is
+	defined. A key built with unchecked outside its bounds is caught by one
+	compare, and throws std::out_of_range.
+
+		typedef safe<int, range_validation<int, int_<1>, int_<65535> >, int_<1> > port;
+		safe_index_map<port, std::string> services;
+		services[port(443)] = "https";
+
+	safe_index_map holds one Value per possible key and a byte marking the
+	keys in use. safe_index_set holds a byte per key, and safe_index_bitset
+	a bit per key, for ranges where memory matters more than a shift and a
+	mask. Storage is allocated when the container is constructed, so the
+	key range should be small enough to hold in full.
+*/
+
+#ifndef SAFE_DATA_INDEX_MPN_18OCT2026_HPP
+#define SAFE_DATA_INDEX_MPN_18OCT2026_HPP
+
+#include "safe_data/safe.h"
+#include "safe_data/simd.h"
+#include "safe_data/validations.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace safe_data {
+namespace safe_detail {
+
+// true when the key's initial value is known at compile time and inside its bounds;
+// an initial type that is the raw type itself starts at 0
+template <class Key, class I = typename Key::initial_type, bool = has_value<I>::value>
+struct initial_in_bounds {
+	typedef static_bounds<typename Key::validation_type> bounds;
+	static bool const value = std::is_same<I, typename Key::raw_type>::value
+		&& bounds::lower <= 0 && 0 <= bounds::upper;
+};
+
+template <class Key, class I>
+struct initial_in_bounds<Key, I, true> {
+	typedef static_bounds<typename Key::validation_type> bounds;
+	static bool const value = bounds::lower <= I::value && I::value <= bounds::upper;
+};
+
+template <class Key>
+struct index_key : dense_key<Key> {
+	static_assert(dense_key<Key>::bounded, "the key needs an integer validation with static bounds");
+	static_assert(dense_key<Key>::width <= 4294967296.0, "the key range is too wide to index");
+	static_assert(initial_in_bounds<Key>::value, "the key needs a constant initial value inside its bounds");
+
+	static std::size_t const size = static_cast<std::size_t>(dense_key<Key>::width);
+
+	static std::size_t index(Key const& k)
+	{
+		unsigned long long const i = dense_key<Key>::key(k.data());
+		if ( i >= size )
+			throw std::out_of_range("the key is outside the bounds of its validation");
+		return static_cast<std::size_t>(i);
+	}
+	static Key key_at(std::size_t i) { return Key(unchecked, dense_key<Key>::value(i)); }
+};
+
+} // namespace safe_detail
+
+
+// safe_index_map - a Value slot for every key in the key's range
+template <class Key, class Value>
+class safe_index_map {
+	typedef safe_detail::index_key<Key> traits;
+public:
+	typedef Key         key_type;
+	typedef Value       mapped_type;
+	typedef std::size_t size_type;
+
+	static size_type const capacity = traits::size;
+
+	safe_index_map() : values_(capacity), used_(capacity), size_(0) { }
+
+	size_type size()  const { return size_; }
+	bool      empty() const { return size_ == 0; }
+
+	bool contains(key_type const& k) const { return used_[traits::index(k)] != 0; }
+
+	// the value for k, default constructed when k is not in the map
+	mapped_type& operator[] (key_type const& k)
+	{
+		size_type const i = traits::index(k);
+		mark(i);
+		return values_[i];
+	}
+
+	// 0 when k is not in the map
+	mapped_type* find(key_type const& k)
+	{
+		size_type const i = traits::index(k);
+		return used_[i] ? &values_[i] : 0;
+	}
+	mapped_type const* find(key_type const& k) const
+	{
+		size_type const i = traits::index(k);
+		return used_[i] ? &values_[i] : 0;
+	}
+
+	// false, and the map unchanged, when k is already in the map
+	bool insert(key_type const& k, mapped_type const& v)
+	{
+		size_type const i = traits::index(k);
+		if ( used_[i] )
+			return false;
+		values_[i] = v;
+		mark(i);
+		return true;
+	}
+
+	bool erase(key_type const& k)
+	{
+		size_type const i = traits::index(k);
+		if ( !used_[i] )
+			return false;
+		used_[i] = 0;
+		values_[i] = mapped_type();
+		--size_;
+		return true;
+	}
+
+	void clear()
+	{
+		for (size_type i = 0; i < capacity; ++i)
+			if ( used_[i] ) {
+				used_[i] = 0;
+				values_[i] = mapped_type();
+			}
+		size_ = 0;
+	}
+
+	// calls f(key, value) for each key in the map, in key order
+	template <class F>
+	void for_each(F f)
+	{
+		for (size_type i = 0; i < capacity; ++i)
+			if ( used_[i] )
+				f(traits::key_at(i), values_[i]);
+	}
+	template <class F>
+	void for_each(F f) const
+	{
+		for (size_type i = 0; i < capacity; ++i)
+			if ( used_[i] )
+				f(traits::key_at(i), values_[i]);
+	}
+
+private:
+	void mark(size_type i)
+	{
+		if ( !used_[i] ) {
+			used_[i] = 1;
+			++size_;
+		}
+	}
+
+	std::vector<mapped_type>   values_;
+	std::vector<unsigned char> used_;
+	size_type                  size_;
+};
+
+template <class Key, class Value>
+typename safe_index_map<Key, Value>::size_type const safe_index_map<Key, Value>::capacity;
+
+
+// safe_index_set - a byte for every key in the key's range
+template <class Key>
+class safe_index_set {
+	typedef safe_detail::index_key<Key> traits;
+public:
+	typedef Key         key_type;
+	typedef std::size_t size_type;
+
+	static size_type const capacity = traits::size;
+
+	safe_index_set() : used_(capacity), size_(0) { }
+
+	size_type size()  const { return size_; }
+	bool      empty() const { return size_ == 0; }
+
+	bool contains(key_type const& k) const { return used_[traits::index(k)] != 0; }
+
+	bool insert(key_type const& k)
+	{
+		unsigned char& u = used_[traits::index(k)];
+		if ( u )
+			return false;
+		u = 1;
+		++size_;
+		return true;
+	}
+
+	bool erase(key_type const& k)
+	{
+		unsigned char& u = used_[traits::index(k)];
+		if ( !u )
+			return false;
+		u = 0;
+		--size_;
+		return true;
+	}
+
+	void clear() { used_.assign(capacity, 0); size_ = 0; }
+
+	// calls f(key) for each key in the set, in key order
+	template <class F>
+	void for_each(F f) const
+	{
+		for (size_type i = 0; i < capacity; ++i)
+			if ( used_[i] )
+				f(traits::key_at(i));
+	}
+
+private:
+	std::vector<unsigned char> used_;
+	size_type                  size_;
+};
+
+template <class Key>
+typename safe_index_set<Key>::size_type const safe_index_set<Key>::capacity;
+
+
+// safe_index_bitset - a bit for every key in the key's range
+template <class Key>
+class safe_index_bitset {
+	typedef safe_detail::index_key<Key> traits;
+public:
+	typedef Key         key_type;
+	typedef std::size_t size_type;
+
+	static size_type const capacity = traits::size;
+
+	safe_index_bitset() : words_((capacity + 63) / 64), size_(0) { }
+
+	size_type size()  const { return size_; }
+	bool      empty() const { return size_ == 0; }
+
+	bool contains(key_type const& k) const
+	{
+		size_type const i = traits::index(k);
+		return (words_[i >> 6] >> (i & 63)) & 1;
+	}
+
+	bool insert(key_type const& k)
+	{
+		size_type const i = traits::index(k);
+		unsigned long long const bit = 1ULL << (i & 63);
+		unsigned long long& w = words_[i >> 6];
+		if ( w & bit )
+			return false;
+		w |= bit;
+		++size_;
+		return true;
+	}
+
+	bool erase(key_type const& k)
+	{
+		size_type const i = traits::index(k);
+		unsigned long long const bit = 1ULL << (i & 63);
+		unsigned long long& w = words_[i >> 6];
+		if ( !(w & bit) )
+			return false;
+		w &= ~bit;
+		--size_;
+		return true;
+	}
+
+	void clear() { words_.assign(words_.size(), 0); size_ = 0; }
+
+	// calls f(key) for each key in the set, in key order
+	template <class F>
+	void for_each(F f) const
+	{
+		for (size_type w = 0; w < words_.size(); ++w)
+			for (unsigned long long bits = words_[w]; bits; bits &= bits - 1)
+				f(traits::key_at(w * 64 + safe_detail::trailing_zeros(bits)));
+	}
+
+private:
+	std::vector<unsigned long long> words_;
+	size_type                       size_;
+};
+
+template <class Key>
+typename safe_index_bitset<Key>::size_type const safe_index_bitset<Key>::capacity;
+
+} // namespace safe_data
+
+#endif
@@ -0,0 +1,220 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/interned.h
+
+Created: 2026.10.18
+
+Description:
+	Interned, validated strings for values that repeat many times, such as
+	host names, tags and units. Each distinct value is stored once in a pool
+	shared by every interned_safe_string with the same validation. The
+	handle is one pointer, so copies are free, and equality and hashing are
+	O(1).
+
+		typedef interned_safe_string<str_length_validation<std::string, size_t<64> > > host;
+		host a(std::string("db01")), b(std::string("db01"));   // a == b, one copy of "db01"
+
+	A value is validated only when it is first added to the pool. Looking a
+	value up takes no lock: each bucket is a chain of immutable nodes, and a
+	new node is published with a compare-and-swap on the bucket head.
+
+	The pool is never destroyed, so an interned string held by a static or
+	thread_local object stays readable while the program shuts down. The
+	pool never rehashes. With n distinct values, a lookup walks a chain of
+	about n / buckets nodes, so set the buckets template argument close to
+	the number of distinct values expected. The default of 1024 suits pools
+	of a few thousand values.
+*/
+
+#ifndef SAFE_DATA_INTERNED_MPN_18OCT2026_HPP
+#define SAFE_DATA_INTERNED_MPN_18OCT2026_HPP
+
+#include "safe_data/safe.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <string>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+namespace safe_data {
+namespace safe_detail {
+
+// FNV-1a, the same for every standard library
+inline std::size_t hash_bytes(char const* data, std::size_t size)
+{
+	unsigned long long h = 14695981039346656037ULL;
+	for (std::size_t i = 0; i < size; ++i) {
+		h ^= static_cast<unsigned char>(data[i]);
+		h *= 1099511628211ULL;
+	}
+	return static_cast<std::size_t>(h ^ (h >> 32));
+}
+
+struct intern_node {
+	intern_node(char const* data, std::size_t len, std::size_t h) : value(data, len), hash(h), next(0) { }
+
+	std::string const  value;
+	std::size_t const  hash;
+	intern_node const* next;
+};
+
+template <class validation, std::size_t buckets>
+class intern_pool {
+	static_assert((buckets & (buckets - 1)) == 0, "the bucket count must be a power of two");
+
+	intern_pool(intern_pool const&);
+	intern_pool& operator= (intern_pool const&);
+public:
+	// deliberately leaked, so it outlives every interned string
+	static intern_pool& instance()
+	{
+		static intern_pool* pool = new intern_pool;
+		return *pool;
+	}
+
+	std::size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+	// the node holding data; data is validated only when it is not yet in the pool
+	intern_node const* intern(char const* data, std::size_t len)
+	{
+		std::size_t const hash = hash_bytes(data, len);
+		std::atomic<intern_node const*>& head = heads_[hash & (buckets - 1)];
+
+		intern_node const* first = head.load(std::memory_order_acquire);
+		if ( intern_node const* found = find(first, 0, hash, data, len) )
+			return found;
+
+		intern_node* node = new intern_node(data, len, hash);
+		try {
+			validation::validate(node->value);
+		}
+		catch (...) {
+			delete node;
+			throw;
+		}
+
+		for (;;) {
+			node->next = first;
+			intern_node const* seen = first;
+			if ( head.compare_exchange_weak(first, node,
+					std::memory_order_release, std::memory_order_acquire) ) {
+				size_.fetch_add(1, std::memory_order_relaxed);
+				return node;
+			}
+			// only the nodes added since the last look can be a match
+			if ( intern_node const* found = find(first, seen, hash, data, len) ) {
+				delete node;
+				return found;
+			}
+		}
+	}
+
+private:
+	intern_pool() : size_(0)
+	{
+		for (std::size_t b = 0; b < buckets; ++b)
+			heads_[b].store(0, std::memory_order_relaxed);
+	}
+
+	static intern_node const* find(intern_node const* node, intern_node const* stop,
+		std::size_t hash, char const* data, std::size_t len)
+	{
+		for (; node != stop; node = node->next)
+			if ( node->hash == hash && node->value.size() == len
+					&& std::memcmp(node->value.data(), data, len) == 0 )
+				return node;
+		return 0;
+	}
+
+	std::atomic<intern_node const*> heads_[buckets];
+	std::atomic<std::size_t>        size_;
+};
+
+} // namespace safe_detail
+
+
+// interned_safe_string - throws the validation's exception when a new value is invalid
+template <class validation, std::size_t buckets = 1024>
+class interned_safe_string {
+	typedef safe_detail::intern_pool<validation, buckets> pool_type;
+public:
+	typedef validation                       validation_type;
+	typedef safe<std::string, validation>    safe_type;
+
+	interned_safe_string() : node_(intern("", 0)) { }
+	explicit interned_safe_string(std::string const& str) : node_(intern(str.data(), str.size())) { }
+	explicit interned_safe_string(char const* str) : node_(intern(str, std::strlen(str))) { }
+	template <class I>
+	explicit interned_safe_string(safe<std::string, validation, I> const& str) :
+		node_(intern(str.data().data(), str.data().size()))
+	{ }
+#if __cplusplus >= 201703L
+	explicit interned_safe_string(std::string_view str) : node_(intern(str.data(), str.size())) { }
+#endif
+
+// access
+	std::string const& str() const { return node_->value; }
+	operator std::string const& () const { return node_->value; }
+	safe_type to_safe() const { return safe_type(unchecked, node_->value); }
+#if __cplusplus >= 201703L
+	std::string_view view() const { return node_->value; }
+#endif
+
+	char const* data() const { return node_->value.data(); }
+	std::size_t size() const { return node_->value.size(); }
+	bool       empty() const { return node_->value.empty(); }
+
+	// the same for equal values
+	std::size_t hash() const { return node_->hash; }
+
+	// number of distinct values interned with this validation
+	static std::size_t pool_size() { return pool_type::instance().size(); }
+
+// compare
+	bool operator== (interned_safe_string const& rhs) const { return node_ == rhs.node_; }
+	bool operator!= (interned_safe_string const& rhs) const { return node_ != rhs.node_; }
+	bool operator<  (interned_safe_string const& rhs) const
+	{ return node_ != rhs.node_ && node_->value < rhs.node_->value; }
+
+private:
+	static safe_detail::intern_node const* intern(char const* data, std::size_t len)
+	{ return pool_type::instance().intern(data, len); }
+
+	safe_detail::intern_node const* node_;
+};
+
+template <class V, std::size_t B, class Elem, class Traits>
+inline std::basic_ostream<Elem, Traits>&
+	operator<< (
+		std::basic_ostream<Elem, Traits>& out,
+		interned_safe_string<V,B> const& s
+	)
+{
+	out << s.str();
+	return out;
+}
+
+} // namespace safe_data
+
+
+namespace std {
+
+template <class V, std::size_t B>
+struct hash<safe_data::interned_safe_string<V,B> > {
+	typedef safe_data::interned_safe_string<V,B> argument_type;
+	typedef std::size_t                           result_type;
+
+	std::size_t operator() (argument_type const& s) const { return s.hash(); }
+};
+
+} // namespace std
+
+#endif
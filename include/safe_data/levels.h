@@ -0,0 +1,133 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/levels.h
+
+Created: 2026.10.18
+
+Description:
+	Validation levels for safe<>. Wrap any validation in leveled_validation to
+	choose per type whether it always runs, runs only in debug builds, runs on
+	1 in N writes, or never runs. Define SAFE_DATA_DEFAULT_VALIDATION_LEVEL
+	and SAFE_DATA_DEFAULT_SAMPLE_RATE before including this header to change
+	the defaults for every type at once.
+
+	Sampled violations go to the handler installed with set_violation_handler.
+	Without a handler the validation exception is thrown as usual.
+*/
+
+#ifndef SAFE_DATA_LEVELS_MPN_18OCT2026_HPP
+#define SAFE_DATA_LEVELS_MPN_18OCT2026_HPP
+
+#include "safe_data/safe_detail.h"
+
+#include <atomic>
+#include <exception>
+
+namespace safe_data {
+
+enum validation_level {
+	validate_always,
+	validate_debug_only,
+	validate_sampled,
+	validate_off
+};
+
+#ifndef SAFE_DATA_DEFAULT_VALIDATION_LEVEL
+#define SAFE_DATA_DEFAULT_VALIDATION_LEVEL ::safe_data::validate_always
+#endif
+
+#ifndef SAFE_DATA_DEFAULT_SAMPLE_RATE
+#define SAFE_DATA_DEFAULT_SAMPLE_RATE 64
+#endif
+
+
+// violation handler
+typedef void (*violation_handler)(std::exception const&);
+
+namespace safe_detail {
+
+inline std::atomic<violation_handler>& current_violation_handler()
+{
+	static std::atomic<violation_handler> handler(0);
+	return handler;
+}
+
+} // namespace safe_detail
+
+// returns the previous handler; pass 0 to throw again
+inline violation_handler set_violation_handler(violation_handler handler)
+{ return safe_detail::current_violation_handler().exchange(handler); }
+
+inline violation_handler get_violation_handler()
+{ return safe_detail::current_violation_handler().load(); }
+
+
+namespace safe_detail {
+
+template <validation_level level> struct leveled;
+
+template <> struct leveled<validate_always> {
+	template <class V, unsigned rate, class A>
+	static inline void validate(A const& data) { V::validate(data); }
+};
+
+template <> struct leveled<validate_debug_only> {
+	template <class V, unsigned rate, class A>
+	static inline void validate(A const& data)
+	{
+		#ifndef NDEBUG
+		V::validate(data);
+		#endif
+	}
+};
+
+template <> struct leveled<validate_sampled> {
+	template <class V, unsigned rate, class A>
+	static inline void validate(A const& data)
+	{
+		static thread_local unsigned counter = 0;
+		if ( ++counter < rate )
+			return;
+		counter = 0;
+
+		try {
+			V::validate(data);
+		}
+		catch (std::exception const& e) {
+			violation_handler handler = get_violation_handler();
+			if ( !handler )
+				throw;
+			handler(e);
+		}
+	}
+};
+
+template <> struct leveled<validate_off> {
+	template <class V, unsigned rate, class A>
+	static inline void validate(A const& /*data*/) { }
+};
+
+} // namespace safe_detail
+
+
+template <
+	class validation,
+	validation_level level = SAFE_DATA_DEFAULT_VALIDATION_LEVEL,
+	unsigned sample_rate   = SAFE_DATA_DEFAULT_SAMPLE_RATE
+>
+struct leveled_validation {
+	typedef validation validation_type;
+
+	static validation_level const level_value = level;
+	static unsigned const         rate_value  = sample_rate;
+
+	template <class A>
+	static inline void validate(A const& data)
+	{ safe_detail::leveled<level>::template validate<validation, sample_rate>(data); }
+};
+
+} // namespace safe_data
+
+#endif
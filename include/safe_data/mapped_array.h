@@ -0,0 +1,153 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/mapped_array.h
+
+Created: 2026.10.18
+
+Description:
+	Memory-mapped array of fixed-width records. The whole mapping is validated
+	once when the file is opened, split across all cores. Elements are then
+	read in place as safe<T const&> without being validated again. Writable
+	mappings validate each element as it is written.
+
+	Requires POSIX mmap.
+*/
+
+#ifndef SAFE_DATA_MAPPED_ARRAY_MPN_18OCT2026_HPP
+#define SAFE_DATA_MAPPED_ARRAY_MPN_18OCT2026_HPP
+
+#include "safe_data/safe.h"
+#include "safe_data/exceptions.h"
+#include "safe_data/parallel.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+namespace safe_data {
+
+enum mapping_mode {
+	map_read_only,
+	map_read_write
+};
+
+
+// mapped_safe_array - throws element_exception when the file holds invalid records
+template <class T, class validation = no_validation<T> >
+class mapped_safe_array {
+	static_assert(std::is_trivially_copyable<T>::value,
+		"mapped_safe_array requires fixed-width, trivially copyable records");
+
+	mapped_safe_array(mapped_safe_array const&);
+	mapped_safe_array& operator= (mapped_safe_array const&);
+public:
+	typedef T                        value_type;
+	typedef validation               validation_type;
+	typedef safe<T const&, validation> const_reference;
+	typedef T const*                 const_iterator;
+	typedef std::size_t              size_type;
+
+	explicit mapped_safe_array(std::string const& path, mapping_mode mode = map_read_only) :
+		data_(0), size_(0), mode_(mode)
+	{
+		int const fd = ::open(path.c_str(), mode == map_read_only ? O_RDONLY : O_RDWR);
+		if ( fd < 0 )
+			throw std::system_error(errno, std::generic_category(), "open " + path);
+
+		struct stat st;
+		if ( ::fstat(fd, &st) != 0 ) {
+			int const err = errno;
+			::close(fd);
+			throw std::system_error(err, std::generic_category(), "fstat " + path);
+		}
+		std::size_t const bytes = static_cast<std::size_t>(st.st_size);
+		if ( bytes % sizeof(T) != 0 ) {
+			::close(fd);
+			throw std::length_error("The size of " + path + " is not a multiple of the record size.");
+		}
+
+		if ( bytes != 0 ) {
+			int const prot = mode == map_read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+			void* p = ::mmap(0, bytes, prot, MAP_SHARED, fd, 0);
+			if ( p == MAP_FAILED ) {
+				int const err = errno;
+				::close(fd);
+				throw std::system_error(err, std::generic_category(), "mmap " + path);
+			}
+			data_ = static_cast<T*>(p);
+			size_ = bytes / sizeof(T);
+		}
+		::close(fd);
+
+		try {
+			parallel_validate<validation_type>(data_, size_, parallel_options(collect_all_failures));
+		}
+		catch (...) {
+			unmap();
+			throw;
+		}
+	}
+
+	~mapped_safe_array() { unmap(); }
+
+// access
+	size_type size() const { return size_; }
+	bool     empty() const { return size_ == 0; }
+	bool  writable() const { return mode_ == map_read_write; }
+
+	const_reference operator[] (size_type i) const { return const_reference(unchecked, data_[i]); }
+	const_reference at(size_type i) const
+	{
+		if ( i >= size_ )
+			throw std::out_of_range("mapped_safe_array::at");
+		return (*this)[i];
+	}
+
+	T const* data() const { return data_; }
+	const_iterator begin() const { return data_; }
+	const_iterator end()   const { return data_ + size_; }
+
+// modify - only for map_read_write
+	void set(size_type i, T const& value)
+	{
+		if ( !writable() )
+			throw std::logic_error("mapped_safe_array is read only");
+		if ( i >= size_ )
+			throw std::out_of_range("mapped_safe_array::set");
+		validation_type::validate(value);
+		data_[i] = value;
+	}
+
+	void sync()
+	{
+		if ( size_ != 0 && ::msync(data_, size_ * sizeof(T), MS_SYNC) != 0 )
+			throw std::system_error(errno, std::generic_category(), "msync");
+	}
+
+private:
+	void unmap()
+	{
+		if ( data_ )
+			::munmap(data_, size_ * sizeof(T));
+		data_ = 0;
+		size_ = 0;
+	}
+
+	T*           data_;
+	size_type    size_;
+	mapping_mode mode_;
+};
+
+} // namespace safe_data
+
+#endif
@@ -0,0 +1,186 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/memoized.h
+
+Created: 2026.10.18
+
+Description:
+	Caches the values an expensive validation has accepted, such as a date
+	check, a reference table lookup or a checksum. A value that is already
+	in the cache is not validated again.
+
+		typedef safe<date, memoized_validation<date_validation, 1024, julian_hash> > cached_date;
+
+	Each thread has its own direct-mapped cache of cache_size slots, so a
+	lookup takes no lock. A slot holds the hash and a copy of the value, and
+	a hit compares the value, so a hash collision never skips a validation.
+	Only valid values are cached. The validation must depend on nothing but
+	the value; call clear() after a reference table changes. clear() bumps
+	an epoch that every thread checks on its next lookup, so no thread
+	accepts a value it cached before the change.
+
+	is_valid() goes through the same cache, and exception_type is the
+	wrapped validation's, when it has one. stats() returns the calling
+	thread's hit and miss counts.
+*/
+
+#ifndef SAFE_DATA_MEMOIZED_MPN_18OCT2026_HPP
+#define SAFE_DATA_MEMOIZED_MPN_18OCT2026_HPP
+
+#include "safe_data/safe_detail.h"
+
+#include <boost/functional/hash.hpp>
+#include <boost/optional.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace safe_data {
+
+struct memo_stats {
+	unsigned long long hits;
+	unsigned long long misses;
+
+	double hit_rate() const
+	{ return hits + misses ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0; }
+};
+
+namespace safe_detail {
+
+struct memo_hash {
+	template <class A>
+	std::size_t operator() (A const& data) const { return boost::hash<A>()(data); }
+};
+
+template <class A, std::size_t size>
+struct memo_cache {
+	struct slot {
+		std::size_t        hash;
+		boost::optional<A> value;
+	};
+
+	memo_cache() : epoch(0) { }
+
+	unsigned long epoch;   // the clear() count the slots were filled under
+	slot          slots[size];
+};
+
+// exception_type of the wrapped validation, when it has one
+template <class V, class = void>
+struct memo_exception { };
+
+template <class V>
+struct memo_exception<V, typename std::conditional<true, void, typename V::exception_type>::type> {
+	typedef typename V::exception_type exception_type;
+};
+
+template <class V, class A>
+inline bool memo_is_valid(A const& data, std::true_type) { return V::is_valid(data); }
+
+template <class V, class A>
+inline bool memo_is_valid(A const& data, std::false_type)
+{
+	try {
+		V::validate(data);
+		return true;
+	}
+	catch (...) {
+		return false;
+	}
+}
+
+} // namespace safe_detail
+
+
+template <
+	class validation,
+	std::size_t cache_size = 256,
+	class hash             = safe_detail::memo_hash
+>
+struct memoized_validation : safe_detail::memo_exception<validation> {
+	static_assert(cache_size && (cache_size & (cache_size - 1)) == 0, "the cache size must be a power of two");
+
+	typedef validation validation_type;
+
+	template <class A>
+	static inline void validate(A const& data)
+	{
+		std::size_t const h = hash()(data);
+		typename safe_detail::memo_cache<A, cache_size>::slot* s;
+		if ( find(data, h, s) )
+			return;
+		validation::validate(data);
+		s->hash = h;
+		s->value = data;
+	}
+
+	template <class A>
+	static inline bool is_valid(A const& data)
+	{
+		std::size_t const h = hash()(data);
+		typename safe_detail::memo_cache<A, cache_size>::slot* s;
+		if ( find(data, h, s) )
+			return true;
+		if ( !safe_detail::memo_is_valid<validation>(data,
+				std::integral_constant<bool, safe_detail::has_is_valid<validation, A>::value>()) )
+			return false;
+		s->hash = h;
+		s->value = data;
+		return true;
+	}
+
+	static memo_stats stats() { return counters(); }
+	static void reset_stats() { counters() = memo_stats(); }
+
+	// forgets the cached values of type A in every thread
+	template <class A>
+	static void clear() { epoch<A>().fetch_add(1, std::memory_order_acq_rel); }
+
+private:
+	// points s at this thread's slot for hash h; true, and a hit, when it holds data
+	template <class A>
+	static bool find(A const& data, std::size_t h, typename safe_detail::memo_cache<A, cache_size>::slot*& s)
+	{
+		safe_detail::memo_cache<A, cache_size>& c = cache<A>();
+		unsigned long const e = epoch<A>().load(std::memory_order_acquire);
+		if ( c.epoch != e ) {
+			c = safe_detail::memo_cache<A, cache_size>();
+			c.epoch = e;
+		}
+
+		s = &c.slots[h & (cache_size - 1)];
+		if ( s->value && s->hash == h && *s->value == data ) {
+			++counters().hits;
+			return true;
+		}
+		++counters().misses;
+		return false;
+	}
+
+	template <class A>
+	static std::atomic<unsigned long>& epoch()
+	{
+		static std::atomic<unsigned long> e(0);
+		return e;
+	}
+
+	template <class A>
+	static safe_detail::memo_cache<A, cache_size>& cache()
+	{
+		static thread_local safe_detail::memo_cache<A, cache_size> c;
+		return c;
+	}
+
+	static memo_stats& counters()
+	{
+		static thread_local memo_stats s = memo_stats();
+		return s;
+	}
+};
+
+} // namespace safe_data
+
+#endif
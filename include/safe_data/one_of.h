@@ -0,0 +1,335 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/one_of.h
+
+Created: 2026.10.18
+
+Description:
+	Set membership validations for codes, opcodes and other enum-like values.
+
+		typedef safe<unsigned short, one_of_validation<unsigned short, 200, 201, 204, 404> > status;
+		typedef safe<std::string, one_of_str_validation<std::string, "USD", "EUR", "JPY"> > currency;
+
+	The table is built at compile time. Sets of 8 and 16 bit values, and of
+	enums with such underlying types, are bitmaps. Wider values and short
+	strings are looked up in a perfect hash table: a multiply-shift hash
+	picks the one slot a member could be in, and one compare decides. A
+	perfect hash is searched for during compilation, and the build fails if
+	none is found.
+
+	Strings of up to 8 bytes are packed into a 64 bit key. Requires C++14;
+	one_of_str_validation requires C++20.
+*/
+
+#ifndef SAFE_DATA_ONE_OF_MPN_18OCT2026_HPP
+#define SAFE_DATA_ONE_OF_MPN_18OCT2026_HPP
+
+#if __cplusplus < 201402L
+#error "safe_data/one_of.h requires C++14"
+#endif
+
+#include "safe_data/safe_detail.h"
+#include "safe_data/exceptions.h"
+#include "safe_data/values.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace safe_data {
+namespace safe_detail {
+
+template <class T, bool = std::is_enum<T>::value>
+struct key_type {
+	typedef T                                     value_type;
+	typedef typename std::make_unsigned<T>::type type;
+};
+
+template <class T>
+struct key_type<T, true> {
+	typedef typename std::underlying_type<T>::type value_type;
+	typedef typename std::make_unsigned<value_type>::type type;
+};
+
+// bitmap over the whole domain of an 8 or 16 bit key
+template <class K, std::size_t N>
+struct bitmap_table {
+	static std::size_t const words = (std::size_t(1) << (8 * sizeof(K))) / 64;
+	std::uint64_t bits[words];
+
+	constexpr bitmap_table(K const (&keys)[N]) : bits()
+	{
+		for (std::size_t i = 0; i < N; ++i)
+			bits[keys[i] >> 6] |= std::uint64_t(1) << (keys[i] & 63);
+	}
+
+	bool contains(K key) const { return (bits[key >> 6] >> (key & 63)) & 1; }
+};
+
+constexpr std::uint64_t next_multiplier(std::uint64_t& state)
+{
+	// splitmix64
+	std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return (z ^ (z >> 31)) | 1;
+}
+
+constexpr std::size_t slot_of(std::uint64_t key, std::uint64_t multiplier, unsigned bits)
+{ return static_cast<std::size_t>((key * multiplier) >> (64 - bits)); }
+
+struct hash_params {
+	std::uint64_t multiplier;
+	unsigned      bits;
+	bool          found;
+	bool          unique;
+};
+
+// log2 of the smallest table with at least 2N slots
+constexpr unsigned min_table_bits(std::size_t n)
+{
+	unsigned bits = 1;
+	while ( (std::size_t(1) << bits) < 2 * n )
+		++bits;
+	return bits;
+}
+
+// a multiplier that sends every key to its own slot, for the smallest table
+// of 2N to 32N slots that has one
+template <std::size_t N>
+constexpr hash_params find_perfect_hash(std::uint64_t const (&keys)[N])
+{
+	hash_params p = { 0, 0, false, true };
+	for (std::size_t i = 0; i < N; ++i)
+		for (std::size_t j = 0; j < i; ++j)
+			if ( keys[i] == keys[j] )
+				p.unique = false;
+	if ( !p.unique )
+		return p;
+
+	unsigned const min_bits = min_table_bits(N);
+
+	// the attempt that last used each slot, so a slot table never needs clearing
+	int used[std::size_t(1) << (min_table_bits(N) + 4)] = {};
+	int stamp = 0;
+
+	for (unsigned bits = min_bits; bits <= min_bits + 4 && bits < 32; ++bits) {
+		std::uint64_t state = bits;
+		for (int attempt = 0; attempt < 512; ++attempt) {
+			std::uint64_t const m = next_multiplier(state);
+			++stamp;
+			bool distinct = true;
+			for (std::size_t i = 0; i < N && distinct; ++i) {
+				std::size_t const slot = slot_of(keys[i], m, bits);
+				distinct = used[slot] != stamp;
+				used[slot] = stamp;
+			}
+			if ( distinct ) {
+				p.multiplier = m;
+				p.bits = bits;
+				p.found = true;
+				return p;
+			}
+		}
+	}
+	return p;
+}
+
+// perfect hash table of keys; an empty slot holds a member of another slot,
+// so it never compares equal to a key that hashes to it
+template <std::size_t Size>
+struct hash_table {
+	std::uint64_t keys[Size];
+	std::uint8_t  lengths[Size];
+
+	template <std::size_t N>
+	constexpr hash_table(std::uint64_t const (&k)[N], std::uint8_t const (&len)[N],
+			hash_params const& p) : keys(), lengths()
+	{
+		bool used[Size] = {};
+		for (std::size_t i = 0; i < N; ++i) {
+			std::size_t const slot = slot_of(k[i], p.multiplier, p.bits);
+			keys[slot] = k[i];
+			lengths[slot] = len[i];
+			used[slot] = true;
+		}
+		for (std::size_t s = 0; s < Size; ++s)
+			if ( !used[s] ) {
+				keys[s] = k[0];
+				lengths[s] = len[0];
+			}
+	}
+};
+
+template <std::size_t N, std::uint64_t const (&Keys)[N], std::uint8_t const (&Lengths)[N]>
+struct perfect_set {
+	static constexpr hash_params params = find_perfect_hash(Keys);
+	static_assert(params.unique, "one_of values must be distinct");
+	static_assert(params.found, "no perfect hash found for the one_of values");
+
+	static constexpr hash_table<(std::size_t(1) << params.bits)> table =
+		hash_table<(std::size_t(1) << params.bits)>(Keys, Lengths, params);
+
+	static bool contains(std::uint64_t key, std::uint8_t length = 0)
+	{
+		std::size_t const slot = slot_of(key, params.multiplier, params.bits);
+		return table.keys[slot] == key && table.lengths[slot] == length;
+	}
+};
+
+template <std::size_t N, std::uint64_t const (&Keys)[N], std::uint8_t const (&Lengths)[N]>
+constexpr hash_params perfect_set<N, Keys, Lengths>::params;
+
+template <std::size_t N, std::uint64_t const (&Keys)[N], std::uint8_t const (&Lengths)[N]>
+constexpr hash_table<(std::size_t(1) << perfect_set<N, Keys, Lengths>::params.bits)>
+	perfect_set<N, Keys, Lengths>::table;
+
+template <class K, K... values>
+struct key_array {
+	static constexpr std::size_t size = sizeof...(values);
+	static constexpr K                keys[size] = { values... };
+	static constexpr std::uint64_t    wide[size] = { std::uint64_t(values)... };
+	static constexpr std::uint8_t     lengths[size] = {};
+};
+
+template <class K, K... values> constexpr K             key_array<K, values...>::keys[];
+template <class K, K... values> constexpr std::uint64_t key_array<K, values...>::wide[];
+template <class K, K... values> constexpr std::uint8_t  key_array<K, values...>::lengths[];
+
+// bitmap for 8 and 16 bit keys
+template <class K, K... values>
+struct bitmap_set {
+	typedef key_array<K, values...> array;
+	static constexpr bitmap_table<K, array::size> table = bitmap_table<K, array::size>(array::keys);
+	static bool contains(K key) { return table.contains(key); }
+};
+
+template <class K, K... values>
+constexpr bitmap_table<K, key_array<K, values...>::size> bitmap_set<K, values...>::table;
+
+// perfect hash for wider keys
+template <class K, K... values>
+struct hash_set {
+	typedef key_array<K, values...> array;
+	static bool contains(K key)
+	{ return perfect_set<array::size, array::wide, array::lengths>::contains(key); }
+};
+
+} // namespace safe_detail
+
+
+template <class T>
+struct one_of_exception : public std::invalid_argument {
+	typedef std::invalid_argument base;
+	typedef T value_type;
+	typedef typename safe_detail::types<T>::argument_type argument_type;
+
+	explicit one_of_exception(argument_type data) : base(one_of_msg(data)) { }
+	explicit one_of_exception(std::string const& msg) : base(msg) { }
+
+	static std::string one_of_msg(argument_type data)
+	{
+		std::ostringstream ss;
+		ss  << "The value " << +static_cast<typename safe_detail::key_type<T>::value_type>(data)
+			<< " is not one of the allowed values.";
+		return ss.str();
+	}
+};
+
+// one_of validations for integral and enum types
+template <class T, T... values>
+struct one_of_validation {
+	static_assert(sizeof...(values) > 0, "one_of_validation needs at least one value");
+	static_assert(std::is_integral<T>::value || std::is_enum<T>::value,
+		"one_of_validation needs an integral or enum type; use one_of_str_validation for strings");
+
+	typedef one_of_exception<T> exception_type;
+	typedef typename safe_detail::types<T>::argument_type argument_type;
+	typedef typename safe_detail::key_type<T>::type key_type;
+	typedef typename std::conditional<sizeof(key_type) <= 2,
+		safe_detail::bitmap_set<key_type, static_cast<key_type>(values)...>,
+		safe_detail::hash_set<key_type, static_cast<key_type>(values)...>
+	>::type set_type;
+
+	static inline bool is_valid(argument_type data)
+	{ return set_type::contains(static_cast<key_type>(data)); }
+	static inline void validate(argument_type data)
+	{
+		if ( !is_valid(data) )
+			throw exception_type(data);
+	}
+};
+
+
+#if __cplusplus >= 202002L
+namespace safe_detail {
+
+constexpr std::uint64_t pack_key(char const* str, std::size_t size)
+{
+	std::uint64_t key = 0;
+	for (std::size_t i = 0; i < size; ++i)
+		key |= std::uint64_t(static_cast<unsigned char>(str[i])) << (8 * i);
+	return key;
+}
+
+template <fixed_string... values>
+struct string_keys {
+	static_assert(((values.size() <= 8) && ...), "one_of_str_validation values must be at most 8 bytes");
+
+	static constexpr std::size_t   size = sizeof...(values);
+	static constexpr std::uint64_t keys[size] = { pack_key(values.value, values.size())... };
+	static constexpr std::uint8_t  lengths[size] = { std::uint8_t(values.size())... };
+};
+
+} // namespace safe_detail
+
+template <class T>
+struct one_of_str_exception : public std::invalid_argument {
+	typedef std::invalid_argument base;
+	typedef T value_type;
+	typedef typename safe_detail::types<T>::argument_type argument_type;
+
+	explicit one_of_str_exception(argument_type data) : base(one_of_msg(data)) { }
+
+	static std::string one_of_msg(argument_type data)
+	{
+		std::ostringstream ss;
+		ss  << "The value \"";
+		safe_detail::write_prefix(ss, data, 32);
+		ss  << "\" is not one of the allowed values.";
+		return ss.str();
+	}
+};
+
+// one_of validations for strings and string views of up to 8 bytes
+template <class T, fixed_string... values>
+struct one_of_str_validation {
+	static_assert(sizeof...(values) > 0, "one_of_str_validation needs at least one value");
+
+	typedef one_of_str_exception<T> exception_type;
+	typedef typename safe_detail::types<T>::argument_type argument_type;
+	typedef safe_detail::string_keys<values...> keys_type;
+	typedef safe_detail::perfect_set<keys_type::size, keys_type::keys, keys_type::lengths> set_type;
+
+	static inline bool is_valid(argument_type str)
+	{
+		return str.size() <= 8
+			&& set_type::contains(safe_detail::pack_key(str.data(), str.size()),
+				static_cast<std::uint8_t>(str.size()));
+	}
+	static inline void validate(argument_type str)
+	{
+		if ( !is_valid(str) )
+			throw exception_type(str);
+	}
+};
+#endif
+
+} // namespace safe_data
+
+#endif
@@ -16,6 +16,8 @@ Description:
 #include "safe_data/safe_fwd.h"
 #include "safe_data/safe_detail.h"
 
+#include <utility>
+
 namespace safe_data {
 
 //
@@ -28,11 +30,13 @@ inline safe<T,V,I> operator+ (safe<T,V,I> const& lhs, safe<T2,V2,I2> const& rhs)
 { return safe<T,V,I>(lhs.data() + rhs.data()); }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I> operator+ (safe<T,V,I> const& lhs, Y const& rhs)
+inline auto operator+ (safe<T,V,I> const& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>, decltype(lhs.data() + rhs)>::type
 { return safe<T,V,I>(lhs.data() + rhs); }
 
 template <class T, class V, class I, class Y>
-inline Y           operator+ (Y const& lhs, safe<T,V,I> const& rhs)
+inline auto operator+ (Y const& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y, decltype(lhs + rhs.data())>::type
 { return lhs + rhs.data(); }
 
 
@@ -42,11 +46,13 @@ inline safe<T,V,I> operator- (safe<T,V,I> const& lhs, safe<T2,V2,I2> const& rhs)
 { return safe<T,V,I>(lhs.data() - rhs.data()); }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I> operator- (safe<T,V,I> const& lhs, Y const& rhs)
+inline auto operator- (safe<T,V,I> const& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>, decltype(lhs.data() - rhs)>::type
 { return safe<T,V,I>(lhs.data() - rhs); }
 
 template <class T, class V, class I, class Y>
-inline Y           operator- (Y const& lhs, safe<T,V,I> const& rhs)
+inline auto operator- (Y const& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y, decltype(lhs - rhs.data())>::type
 { return lhs - rhs.data(); }
 
 
@@ -56,11 +62,13 @@ inline safe<T,V,I> operator* (safe<T,V,I> const& lhs, safe<T2,V2,I2> const& rhs)
 { return safe<T,V,I>(lhs.data() * rhs.data()); }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I> operator* (safe<T,V,I> const& lhs, Y const& rhs)
+inline auto operator* (safe<T,V,I> const& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>, decltype(lhs.data() * rhs)>::type
 { return safe<T,V,I>(lhs.data() * rhs); }
 
 template <class T, class V, class I, class Y>
-inline Y           operator* (Y const& lhs, safe<T,V,I> const& rhs)
+inline auto operator* (Y const& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y, decltype(lhs * rhs.data())>::type
 { return lhs * rhs.data(); }
 
 
@@ -70,11 +78,13 @@ inline safe<T,V,I> operator/ (safe<T,V,I> const& lhs, safe<T2,V2,I2> const& rhs)
 { return safe<T,V,I>(lhs.data() / rhs.data()); }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I> operator/ (safe<T,V,I> const& lhs, Y const& rhs)
+inline auto operator/ (safe<T,V,I> const& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>, decltype(lhs.data() / rhs)>::type
 { return safe<T,V,I>(lhs.data() / rhs); }
 
 template <class T, class V, class I, class Y>
-inline Y           operator/ (Y const& lhs, safe<T,V,I> const& rhs)
+inline auto operator/ (Y const& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y, decltype(lhs / rhs.data())>::type
 { return lhs / rhs.data(); }
 
 // operator %
@@ -83,11 +93,13 @@ inline safe<T,V,I> operator% (safe<T,V,I> const& lhs, safe<T2,V2,I2> const& rhs)
 { return safe<T,V,I>(lhs.data() % rhs.data()); }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I> operator% (safe<T,V,I> const& lhs, Y const& rhs)
+inline auto operator% (safe<T,V,I> const& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>, decltype(lhs.data() % rhs)>::type
 { return safe<T,V,I>(lhs.data() % rhs); }
 
 template <class T, class V, class I, class Y>
-inline Y           operator% (Y const& lhs, safe<T,V,I> const& rhs)
+inline auto operator% (Y const& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y, decltype(lhs % rhs.data())>::type
 { return lhs % rhs.data(); }
 
 
@@ -101,11 +113,13 @@ inline bool operator&& (safe<T,V,I> const& lhs, safe<T2,V2,I2> const& rhs)
 { return lhs.data() && rhs.data(); }
 
 template <class T, class V, class I, class Y>
-inline bool operator&& (safe<T,V,I> const& lhs, Y const& rhs)
+inline auto operator&& (safe<T,V,I> const& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, bool, decltype(lhs.data() && rhs)>::type
 { return lhs.data() && rhs; }
 
 template <class T, class V, class I, class Y>
-inline bool operator&& (Y const& lhs, safe<T,V,I> const& rhs)
+inline auto operator&& (Y const& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, bool, decltype(lhs && rhs.data())>::type
 { return lhs        && rhs.data(); }
 
 
@@ -115,11 +129,13 @@ inline bool operator|| (safe<T,V,I> const& lhs, safe<T2,V2,I2> const& rhs)
 { return lhs.data() || rhs.data(); }
 
 template <class T, class V, class I, class Y>
-inline bool operator|| (safe<T,V,I> const& lhs, Y const& rhs)
+inline auto operator|| (safe<T,V,I> const& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, bool, decltype(lhs.data() || rhs)>::type
 { return lhs.data() || rhs; }
 
 template <class T, class V, class I, class Y>
-inline bool operator|| (Y const& lhs, safe<T,V,I> const& rhs)
+inline auto operator|| (Y const& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, bool, decltype(lhs || rhs.data())>::type
 { return lhs        || rhs.data(); }
 
 //
@@ -132,11 +148,13 @@ inline safe<T,V,I> operator& (safe<T,V,I> const& lhs, safe<T2,V2,I2> const& rhs)
 { return safe<T,V,I>(lhs.data() & rhs.data()); }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I> operator& (safe<T,V,I> const& lhs, Y const& rhs)
+inline auto operator& (safe<T,V,I> const& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>, decltype(lhs.data() & rhs)>::type
 { return safe<T,V,I>(lhs.data() & rhs); }
 
 template <class T, class V, class I, class Y>
-inline Y           operator& (Y const& lhs, safe<T,V,I> const& rhs)
+inline auto operator& (Y const& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y, decltype(lhs & rhs.data())>::type
 { return lhs & rhs.data(); }
 
 // operator |
@@ -145,11 +163,13 @@ inline safe<T,V,I> operator| (safe<T,V,I> const& lhs, safe<T2,V2,I2> const& rhs)
 { return safe<T,V,I>(lhs.data() | rhs.data()); }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I> operator| (safe<T,V,I> const& lhs, Y const& rhs)
+inline auto operator| (safe<T,V,I> const& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>, decltype(lhs.data() | rhs)>::type
 { return safe<T,V,I>(lhs.data() | rhs); }
 
 template <class T, class V, class I, class Y>
-inline Y           operator| (Y const& lhs, safe<T,V,I> const& rhs)
+inline auto operator| (Y const& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y, decltype(lhs | rhs.data())>::type
 { return lhs | rhs.data(); }
 
 
@@ -159,11 +179,13 @@ inline safe<T,V,I> operator^ (safe<T,V,I> const& lhs, safe<T2,V2,I2> const& rhs)
 { return safe<T,V,I>(lhs.data() ^ rhs.data()); }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I> operator^ (safe<T,V,I> const& lhs, Y const& rhs)
+inline auto operator^ (safe<T,V,I> const& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>, decltype(lhs.data() ^ rhs)>::type
 { return safe<T,V,I>(lhs.data() ^ rhs); }
 
 template <class T, class V, class I, class Y>
-inline Y           operator^ (Y const& lhs, safe<T,V,I> const& rhs)
+inline auto operator^ (Y const& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y, decltype(lhs ^ rhs.data())>::type
 { return lhs ^ rhs.data(); }
 
 
@@ -173,11 +195,13 @@ inline safe<T,V,I> operator<< (safe<T,V,I> const& lhs, safe<T2,V2,I2> const& rhs
 { return safe<T,V,I>(lhs.data() << rhs.data()); }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I> operator<< (safe<T,V,I> const& lhs, Y const& rhs)
+inline auto operator<< (safe<T,V,I> const& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>, decltype(lhs.data() << rhs)>::type
 { return safe<T,V,I>(lhs.data() << rhs); }
 
 template <class T, class V, class I, class Y>
-inline Y           operator<< (Y const& lhs, safe<T,V,I> const& rhs)
+inline auto operator<< (Y const& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y, decltype(lhs << rhs.data())>::type
 { return lhs << rhs.data(); }
 
 // operator >>
@@ -186,11 +210,13 @@ inline safe<T,V,I> operator>> (safe<T,V,I> const& lhs, safe<T2,V2,I2> const& rhs
 { return safe<T,V,I>(lhs.data() >> rhs.data()); }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I> operator>> (safe<T,V,I> const& lhs, Y const& rhs)
+inline auto operator>> (safe<T,V,I> const& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>, decltype(lhs.data() >> rhs)>::type
 { return safe<T,V,I>(lhs.data() >> rhs); }
 
 template <class T, class V, class I, class Y>
-inline Y           operator>> (Y const& lhs, safe<T,V,I> const& rhs)
+inline auto operator>> (Y const& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y, decltype(lhs >> rhs.data())>::type
 { return lhs >> rhs.data(); }
 
 
@@ -203,24 +229,27 @@ template <class T, class V, class I, class T2, class V2, class I2>
 inline safe<T,V,I>& operator+= (safe<T,V,I>& lhs, safe<T2,V2,I2> const& rhs)
 {
 	typedef typename safe_detail::types<T>::raw_type raw_type;
-	raw_type data(lhs.data());
+	raw_type data(safe_detail::clone<raw_type>(lhs.data()));
 	data += rhs.data();
-	lhs = data;
+	lhs = safe_detail::move_unless_ref<T>(data);
 	return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I>& operator+= (safe<T,V,I>& lhs, Y const& rhs)
+inline auto operator+= (safe<T,V,I>& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>&,
+		decltype(std::declval<typename safe_detail::types<T>::raw_type&>() += rhs)>::type
 {
 	typedef typename safe_detail::types<T>::raw_type raw_type;
-	raw_type data(lhs.data());
+	raw_type data(safe_detail::clone<raw_type>(lhs.data()));
 	data += rhs;
-	lhs = data;
+	lhs = safe_detail::move_unless_ref<T>(data);
 	return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline Y&           operator+= (Y& lhs, safe<T,V,I> const& rhs)
+inline auto operator+= (Y& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y&, decltype(lhs += rhs.data())>::type
 { lhs += rhs.data(); return lhs; }
 
 
@@ -229,24 +258,27 @@ template <class T, class V, class I, class T2, class V2, class I2>
 inline safe<T,V,I>& operator-= (safe<T,V,I>& lhs, safe<T2,V2,I2> const& rhs)
 {
 	typedef typename safe_detail::types<T>::raw_type raw_type;
-	raw_type data(lhs.data());
+	raw_type data(safe_detail::clone<raw_type>(lhs.data()));
 	data -= rhs.data();
-	lhs = data;
+	lhs = safe_detail::move_unless_ref<T>(data);
 	return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I>& operator-= (safe<T,V,I>& lhs, Y const& rhs)
+inline auto operator-= (safe<T,V,I>& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>&,
+		decltype(std::declval<typename safe_detail::types<T>::raw_type&>() -= rhs)>::type
 {
 	typedef typename safe_detail::types<T>::raw_type raw_type;
-	raw_type data(lhs.data());
+	raw_type data(safe_detail::clone<raw_type>(lhs.data()));
 	data -= rhs;
-	lhs = data;
+	lhs = safe_detail::move_unless_ref<T>(data);
 	return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline Y&           operator-= (Y& lhs, safe<T,V,I> const& rhs)
+inline auto operator-= (Y& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y&, decltype(lhs -= rhs.data())>::type
 { lhs -= rhs.data(); return lhs; }
 
 
@@ -255,24 +287,27 @@ template <class T, class V, class I, class T2, class V2, class I2>
 inline safe<T,V,I>& operator*= (safe<T,V,I>& lhs, safe<T2,V2,I2> const& rhs)
 {
 	typedef typename safe_detail::types<T>::raw_type raw_type;
-	raw_type data(lhs.data());
+	raw_type data(safe_detail::clone<raw_type>(lhs.data()));
 	data *= rhs.data();
-	lhs = data;
+	lhs = safe_detail::move_unless_ref<T>(data);
 	return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I>& operator*= (safe<T,V,I>& lhs, Y const& rhs)
+inline auto operator*= (safe<T,V,I>& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>&,
+		decltype(std::declval<typename safe_detail::types<T>::raw_type&>() *= rhs)>::type
 {
 	typedef typename safe_detail::types<T>::raw_type raw_type;
-	raw_type data(lhs.data());
+	raw_type data(safe_detail::clone<raw_type>(lhs.data()));
 	data *= rhs;
-	lhs = data;
+	lhs = safe_detail::move_unless_ref<T>(data);
 	return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline Y&           operator*= (Y& lhs, safe<T,V,I> const& rhs)
+inline auto operator*= (Y& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y&, decltype(lhs *= rhs.data())>::type
 { lhs *= rhs.data(); return lhs; }
 
 
@@ -281,24 +316,27 @@ template <class T, class V, class I, class T2, class V2, class I2>
 inline safe<T,V,I>& operator/= (safe<T,V,I>& lhs, safe<T2,V2,I2> const& rhs)
 {
 	typedef typename safe_detail::types<T>::raw_type raw_type;
-	raw_type data(lhs.data());
+	raw_type data(safe_detail::clone<raw_type>(lhs.data()));
 	data /= rhs.data();
-	lhs = data;
+	lhs = safe_detail::move_unless_ref<T>(data);
 	return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I>& operator/= (safe<T,V,I>& lhs, Y const& rhs)
+inline auto operator/= (safe<T,V,I>& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>&,
+		decltype(std::declval<typename safe_detail::types<T>::raw_type&>() /= rhs)>::type
 {
 	typedef typename safe_detail::types<T>::raw_type raw_type;
-	raw_type data(lhs.data());
+	raw_type data(safe_detail::clone<raw_type>(lhs.data()));
 	data /= rhs;
-	lhs = data;
+	lhs = safe_detail::move_unless_ref<T>(data);
 	return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline Y&           operator/= (Y& lhs, safe<T,V,I> const& rhs)
+inline auto operator/= (Y& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y&, decltype(lhs /= rhs.data())>::type
 { lhs /= rhs.data(); return lhs; }
 
 
@@ -307,24 +345,27 @@ template <class T, class V, class I, class T2, class V2, class I2>
 inline safe<T,V,I>& operator%= (safe<T,V,I>& lhs, safe<T2,V2,I2> const& rhs)
 {
 	typedef typename safe_detail::types<T>::raw_type raw_type;
-	raw_type data(lhs.data());
+	raw_type data(safe_detail::clone<raw_type>(lhs.data()));
 	data %= rhs.data();
-	lhs = data;
+	lhs = safe_detail::move_unless_ref<T>(data);
 	return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I>& operator%= (safe<T,V,I>& lhs, Y const& rhs)
+inline auto operator%= (safe<T,V,I>& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>&,
+		decltype(std::declval<typename safe_detail::types<T>::raw_type&>() %= rhs)>::type
 {
 	typedef typename safe_detail::types<T>::raw_type raw_type;
-	raw_type data(lhs.data());
+	raw_type data(safe_detail::clone<raw_type>(lhs.data()));
 	data %= rhs;
-	lhs = data;
+	lhs = safe_detail::move_unless_ref<T>(data);
 	return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline Y&           operator%= (Y& lhs, safe<T,V,I> const& rhs)
+inline auto operator%= (Y& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y&, decltype(lhs %= rhs.data())>::type
 { lhs %= rhs.data(); return lhs; }
 
 
@@ -333,24 +374,27 @@ template <class T, class V, class I, class T2, class V2, class I2>
 inline safe<T,V,I>& operator&= (safe<T,V,I>& lhs, safe<T2,V2,I2> const& rhs)
 {
 	typedef typename safe_detail::types<T>::raw_type raw_type;
-	raw_type data(lhs.data());
+	raw_type data(safe_detail::clone<raw_type>(lhs.data()));
 	data &= rhs.data();
-	lhs = data;
+	lhs = safe_detail::move_unless_ref<T>(data);
 	return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I>& operator&= (safe<T,V,I>& lhs, Y const& rhs)
+inline auto operator&= (safe<T,V,I>& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>&,
+		decltype(std::declval<typename safe_detail::types<T>::raw_type&>() &= rhs)>::type
 {
 	typedef typename safe_detail::types<T>::raw_type raw_type;
-	raw_type data(lhs.data());
+	raw_type data(safe_detail::clone<raw_type>(lhs.data()));
 	data &= rhs;
-	lhs = data;
+	lhs = safe_detail::move_unless_ref<T>(data);
 	return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline Y&           operator&= (Y& lhs, safe<T,V,I> const& rhs)
+inline auto operator&= (Y& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y&, decltype(lhs &= rhs.data())>::type
 { lhs &= rhs.data(); return lhs; }
 
 
@@ -360,24 +404,27 @@ template <class T, class V, class I, class T2, class V2, class I2>
 inline safe<T,V,I>& operator|= (safe<T,V,I>& lhs, safe<T2,V2,I2> const& rhs)
 {
 	typedef typename safe_detail::types<T>::raw_type raw_type;
-	raw_type data(lhs.data());
+	raw_type data(safe_detail::clone<raw_type>(lhs.data()));
 	data |= rhs.data();
-	lhs = data;
+	lhs = safe_detail::move_unless_ref<T>(data);
 	return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I>& operator|= (safe<T,V,I>& lhs, Y const& rhs)
+inline auto operator|= (safe<T,V,I>& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>&,
+		decltype(std::declval<typename safe_detail::types<T>::raw_type&>() |= rhs)>::type
 {
 	typedef typename safe_detail::types<T>::raw_type raw_type;
-	raw_type data(lhs.data());
+	raw_type data(safe_detail::clone<raw_type>(lhs.data()));
 	data |= rhs;
-	lhs = data;
+	lhs = safe_detail::move_unless_ref<T>(data);
 	return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline Y&           operator|= (Y& lhs, safe<T,V,I> const& rhs)
+inline auto operator|= (Y& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y&, decltype(lhs |= rhs.data())>::type
 { lhs |= rhs.data(); return lhs; }
 
 
@@ -387,24 +434,27 @@ template <class T, class V, class I, class T2, class V2, class I2>
 inline safe<T,V,I>& operator^= (safe<T,V,I>& lhs, safe<T2,V2,I2> const& rhs)
 {
     typedef typename safe_detail::types<T>::raw_type raw_type;
-    raw_type data(lhs.data());
+    raw_type data(safe_detail::clone<raw_type>(lhs.data()));
     data ^= rhs.data();
-    lhs = data;
+    lhs = safe_detail::move_unless_ref<T>(data);
     return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I>& operator^= (safe<T,V,I>& lhs, Y const& rhs)
+inline auto operator^= (safe<T,V,I>& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>&,
+		decltype(std::declval<typename safe_detail::types<T>::raw_type&>() ^= rhs)>::type
 {
     typedef typename safe_detail::types<T>::raw_type raw_type;
-    raw_type data(lhs.data());
+    raw_type data(safe_detail::clone<raw_type>(lhs.data()));
     data ^= rhs;
-    lhs = data;
+    lhs = safe_detail::move_unless_ref<T>(data);
     return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline Y&           operator^= (Y& lhs, safe<T,V,I> const& rhs)
+inline auto operator^= (Y& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y&, decltype(lhs ^= rhs.data())>::type
 { lhs ^= rhs.data(); return lhs; }
 
     
@@ -414,24 +464,27 @@ template <class T, class V, class I, class T2, class V2, class I2>
 inline safe<T,V,I>& operator<<= (safe<T,V,I>& lhs, safe<T2,V2,I2> const& rhs)
 {
     typedef typename safe_detail::types<T>::raw_type raw_type;
-    raw_type data(lhs.data());
+    raw_type data(safe_detail::clone<raw_type>(lhs.data()));
     data <<= rhs.data();
-    lhs = data;
+    lhs = safe_detail::move_unless_ref<T>(data);
     return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I>& operator<<= (safe<T,V,I>& lhs, Y const& rhs)
+inline auto operator<<= (safe<T,V,I>& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>&,
+		decltype(std::declval<typename safe_detail::types<T>::raw_type&>() <<= rhs)>::type
 {
     typedef typename safe_detail::types<T>::raw_type raw_type;
-    raw_type data(lhs.data());
+    raw_type data(safe_detail::clone<raw_type>(lhs.data()));
     data <<= rhs;
-    lhs = data;
+    lhs = safe_detail::move_unless_ref<T>(data);
     return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline Y&           operator<<= (Y& lhs, safe<T,V,I> const& rhs)
+inline auto operator<<= (Y& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y&, decltype(lhs <<= rhs.data())>::type
 { lhs <<= rhs.data(); return lhs; }
 
     
@@ -440,24 +493,27 @@ template <class T, class V, class I, class T2, class V2, class I2>
 inline safe<T,V,I>& operator>>= (safe<T,V,I>& lhs, safe<T2,V2,I2> const& rhs)
 {
     typedef typename safe_detail::types<T>::raw_type raw_type;
-    raw_type data(lhs.data());
+    raw_type data(safe_detail::clone<raw_type>(lhs.data()));
     data >>= rhs.data();
-    lhs = data;
+    lhs = safe_detail::move_unless_ref<T>(data);
     return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline safe<T,V,I>& operator>>= (safe<T,V,I>& lhs, Y const& rhs)
+inline auto operator>>= (safe<T,V,I>& lhs, Y const& rhs)
+	-> typename safe_detail::raw_operand<Y, safe<T,V,I>&,
+		decltype(std::declval<typename safe_detail::types<T>::raw_type&>() >>= rhs)>::type
 {
     typedef typename safe_detail::types<T>::raw_type raw_type;
-    raw_type data(lhs.data());
+    raw_type data(safe_detail::clone<raw_type>(lhs.data()));
     data >>= rhs;
-    lhs = data;
+    lhs = safe_detail::move_unless_ref<T>(data);
     return lhs;
 }
 
 template <class T, class V, class I, class Y>
-inline Y&           operator>>= (Y& lhs, safe<T,V,I> const& rhs)
+inline auto operator>>= (Y& lhs, safe<T,V,I> const& rhs)
+	-> typename safe_detail::raw_operand<Y, Y&, decltype(lhs >>= rhs.data())>::type
 { lhs >>= rhs.data(); return lhs; }
 
 
@@ -0,0 +1,314 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/parallel.h
+
+Created: 2026.10.18
+
+Description:
+	Element-wise validation of large arrays and containers, split into chunks
+	and run on all cores. Threads pull chunks from a shared counter, so a
+	slow chunk never holds up the others. Validation either stops at the
+	first failure or collects every failing position.
+
+	A validation may provide
+		static std::size_t find_invalid(T const* data, std::size_t size);
+	returning the first failing index (or size) to validate a whole chunk at
+	once instead of element by element.
+
+	An exception of any type thrown by validate() marks the element as
+	failing. Any other exception in a worker, such as std::bad_alloc, stops
+	the other workers and is rethrown to the caller once they have joined.
+*/
+
+#ifndef SAFE_DATA_PARALLEL_MPN_18OCT2026_HPP
+#define SAFE_DATA_PARALLEL_MPN_18OCT2026_HPP
+
+#include "safe_data/safe_detail.h"
+#include "safe_data/exceptions.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace safe_data {
+
+enum failure_mode {
+	stop_on_first_failure,
+	collect_all_failures
+};
+
+struct parallel_options {
+	parallel_options() : mode(stop_on_first_failure), threads(0), chunk_size(1 << 16) { }
+	explicit parallel_options(failure_mode m) : mode(m), threads(0), chunk_size(1 << 16) { }
+
+	failure_mode mode;
+	unsigned     threads;    // 0 uses every core
+	std::size_t  chunk_size; // elements handed to a thread at a time
+};
+
+namespace safe_detail {
+
+template <class V, class T>
+struct has_find_invalid {
+	template <class U, std::size_t (*)(T const*, std::size_t)> struct check;
+	template <class U> static char test(check<U, &U::find_invalid>*);
+	template <class U> static long test(...);
+	static bool const value = sizeof(test<V>(0)) == sizeof(char);
+};
+
+// first failing index in [first, last), or last
+template <class V, class T>
+std::size_t find_invalid(T const* data, std::size_t first, std::size_t last, std::string& msg, std::true_type)
+{
+	std::size_t const i = first + V::find_invalid(data + first, last - first);
+	if ( i != last ) {
+		try { V::validate(data[i]); }
+		catch (std::exception const& e) { msg = e.what(); }
+		catch (...) { }
+	}
+	return i;
+}
+
+template <class V, class T>
+std::size_t find_invalid_each(T const* data, std::size_t first, std::size_t last, std::true_type)
+{
+	for (std::size_t i = first; i < last; ++i)
+		if ( !V::is_valid(data[i]) )
+			return i;
+	return last;
+}
+
+template <class V, class T>
+std::size_t find_invalid_each(T const* data, std::size_t first, std::size_t last, std::false_type)
+{
+	for (std::size_t i = first; i < last; ++i) {
+		try {
+			V::validate(data[i]);
+		}
+		catch (...) {
+			return i;
+		}
+	}
+	return last;
+}
+
+template <class V, class T>
+std::size_t find_invalid(T const* data, std::size_t first, std::size_t last, std::string& msg, std::false_type)
+{
+	std::size_t const i = find_invalid_each<V>(data, first, last,
+		std::integral_constant<bool, has_is_valid<V, T>::value>());
+	if ( i != last ) {
+		try { V::validate(data[i]); }
+		catch (std::exception const& e) { msg = e.what(); }
+		catch (...) { }
+	}
+	return i;
+}
+
+template <class V, class T>
+std::size_t find_invalid(T const* data, std::size_t first, std::size_t last, std::string& msg)
+{
+	return find_invalid<V>(data, first, last, msg,
+		std::integral_constant<bool, has_find_invalid<V, T>::value>());
+}
+
+// joins every started thread, so unwinding never destroys a joinable std::thread
+struct join_threads {
+	explicit join_threads(std::vector<std::thread>& threads) : threads_(threads) { }
+	~join_threads()
+	{
+		for (std::size_t t = 0; t < threads_.size(); ++t)
+			if ( threads_[t].joinable() )
+				threads_[t].join();
+	}
+
+private:
+	join_threads& operator= (join_threads const&);
+	std::vector<std::thread>& threads_;
+};
+
+template <class V, class T>
+class parallel_validator {
+public:
+	parallel_validator(T const* data, std::size_t size, parallel_options const& options) :
+		data_(data), size_(size), options_(options), next_(0), first_bad_(size), lowest_(size)
+	{
+		if ( options_.chunk_size == 0 )
+			options_.chunk_size = 1;
+	}
+
+	void run()
+	{
+		std::size_t const chunks = (size_ + options_.chunk_size - 1) / options_.chunk_size;
+		unsigned threads = options_.threads ? options_.threads : std::thread::hardware_concurrency();
+		threads = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(threads, chunks)));
+
+		std::vector<std::thread> workers;
+		workers.reserve(threads - 1);
+		{
+			join_threads joiner(workers);
+			try {
+				for (unsigned t = 1; t < threads; ++t)
+					workers.push_back(std::thread(&parallel_validator::work, this));
+			}
+			catch (...) {
+				next_.store(size_); // the started workers stop after their current chunk
+				throw;
+			}
+			work();
+		}
+		if ( error_ )
+			std::rethrow_exception(error_);
+
+		std::sort(positions_.begin(), positions_.end());
+	}
+
+	std::size_t first_bad() const { return first_bad_.load(); }
+	std::vector<std::size_t> const& positions() const { return positions_; }
+	std::string const& first_msg() const { return first_msg_; }
+
+private:
+	void work()
+	{
+		try {
+			work_chunks();
+		}
+		catch (...) {
+			std::lock_guard<std::mutex> lock(mutex_);
+			if ( !error_ )
+				error_ = std::current_exception();
+			next_.store(size_);
+		}
+	}
+
+	void work_chunks()
+	{
+		std::vector<std::size_t> found;
+		std::size_t found_first = size_;
+		std::string found_msg;
+
+		for (;;) {
+			std::size_t const first = next_.fetch_add(options_.chunk_size);
+			if ( first >= size_ )
+				break;
+			// chunks are handed out in order, so nothing after the first failure matters
+			if ( options_.mode == stop_on_first_failure && first > first_bad_.load(std::memory_order_relaxed) )
+				break;
+
+			std::size_t const last = std::min(size_, first + options_.chunk_size);
+			for (std::size_t i = first; i < last; ++i) {
+				std::string msg;
+				i = find_invalid<V>(data_, i, last, msg);
+				if ( i == last )
+					break;
+				if ( i < found_first ) {
+					found_first = i;
+					found_msg = msg;
+				}
+				found.push_back(i);
+				if ( options_.mode == stop_on_first_failure ) {
+					lower_first_bad(i);
+					break;
+				}
+			}
+		}
+
+		if ( found.empty() )
+			return;
+		std::lock_guard<std::mutex> lock(mutex_);
+		if ( positions_.empty() || found_first < lowest_ ) {
+			lowest_ = found_first;
+			first_msg_ = found_msg;
+		}
+		positions_.insert(positions_.end(), found.begin(), found.end());
+	}
+
+	void lower_first_bad(std::size_t i)
+	{
+		std::size_t current = first_bad_.load();
+		while ( i < current && !first_bad_.compare_exchange_weak(current, i) )
+			;
+	}
+
+	T const*         data_;
+	std::size_t      size_;
+	parallel_options options_;
+
+	std::atomic<std::size_t> next_;
+	std::atomic<std::size_t> first_bad_;
+
+	std::mutex               mutex_;
+	std::size_t              lowest_;
+	std::vector<std::size_t> positions_;
+	std::string              first_msg_;
+	std::exception_ptr       error_;
+};
+
+} // namespace safe_detail
+
+
+// first index in data that fails validation, or size when all are valid
+template <class validation, class T>
+std::size_t parallel_find_invalid(T const* data, std::size_t size,
+	parallel_options const& options = parallel_options())
+{
+	parallel_options o(options);
+	o.mode = stop_on_first_failure;
+	safe_detail::parallel_validator<validation, T> v(data, size, o);
+	v.run();
+	return v.first_bad();
+}
+
+// throws element_exception with the first failing position, or all of them
+template <class validation, class T>
+void parallel_validate(T const* data, std::size_t size,
+	parallel_options const& options = parallel_options())
+{
+	safe_detail::parallel_validator<validation, T> v(data, size, options);
+	v.run();
+	if ( !v.positions().empty() ) {
+		std::vector<std::size_t> positions(v.positions());
+		if ( options.mode == stop_on_first_failure )
+			positions.resize(1);
+		throw element_exception(positions, v.first_msg());
+	}
+}
+
+// any contiguous container with data() and size()
+template <class validation, class Container>
+void parallel_validate(Container const& c, parallel_options const& options = parallel_options())
+{
+	parallel_validate<validation>(c.data(), c.size(), options);
+}
+
+
+// validates every element of a contiguous container, in parallel once it is large
+template <class T, class element_validation, std::size_t parallel_threshold = (1 << 20)>
+struct elements_validation {
+	typedef element_validation element_validation_type;
+	typedef element_exception  exception_type;
+	typedef typename safe_detail::types<T>::argument_type argument_type;
+	static inline void validate(argument_type container) {
+		if ( container.size() >= parallel_threshold ) {
+			parallel_validate<element_validation>(container);
+			return;
+		}
+		std::string msg;
+		std::size_t const i = safe_detail::find_invalid<element_validation>(
+			container.data(), 0, container.size(), msg);
+		if ( i != container.size() )
+			throw exception_type(std::vector<std::size_t>(1, i), msg);
+	}
+};
+
+} // namespace safe_data
+
+#endif
@@ -0,0 +1,383 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/pattern.h
+
+Created: 2026.10.18
+
+Description:
+	String validation against a pattern that is compiled into a DFA at compile
+	time. Matching costs two table lookups per character, and no regex object
+	is built at run time. The whole string must match.
+
+		typedef safe<std::string, pattern_validation<std::string, "[A-Za-z_][A-Za-z0-9_]*"> > identifier;
+
+	Supported syntax, a sequence of atoms each with an optional quantifier:
+		atoms        c  .  [abc]  [a-z]  [^...]  \d \w \s \D \W \S  \c (escaped c)
+		quantifiers  ?  *  +  {n}  {n,}  {n,m}
+	Alternation and groups are not supported. A pattern may expand to at most
+	63 positions (a{3} counts as 3) and 255 DFA states.
+
+	Requires C++20.
+*/
+
+#ifndef SAFE_DATA_PATTERN_MPN_18OCT2026_HPP
+#define SAFE_DATA_PATTERN_MPN_18OCT2026_HPP
+
+#if __cplusplus < 202002L
+#error "safe_data/pattern.h requires C++20"
+#endif
+
+#include "safe_data/safe_detail.h"
+#include "safe_data/exceptions.h"
+#include "safe_data/values.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace safe_data {
+namespace safe_detail {
+
+struct pattern_charset {
+	std::uint64_t bits[4] = { 0, 0, 0, 0 };
+
+	constexpr void add(unsigned char c) { bits[c >> 6] |= std::uint64_t(1) << (c & 63); }
+	constexpr void add(unsigned char first, unsigned char last)
+	{
+		for (unsigned c = first; c <= last; ++c)
+			add(static_cast<unsigned char>(c));
+	}
+	constexpr void add(pattern_charset const& other)
+	{
+		for (int i = 0; i < 4; ++i)
+			bits[i] |= other.bits[i];
+	}
+	constexpr void invert()
+	{
+		for (int i = 0; i < 4; ++i)
+			bits[i] = ~bits[i];
+	}
+	constexpr bool has(unsigned char c) const { return (bits[c >> 6] >> (c & 63)) & 1; }
+};
+
+struct pattern_position {
+	pattern_charset chars;
+	bool optional = false; // may be skipped
+	bool loop = false;     // may repeat
+};
+
+// linear Glushkov automaton: bit 0 is the start state, bit p + 1 is position p
+struct pattern_nfa {
+	static constexpr std::size_t max_positions = 63;
+	pattern_position positions[max_positions];
+	std::size_t count = 0;
+};
+
+// not constexpr, so reaching it while compiling a pattern is a compile error
+inline void pattern_error(char const* what)
+{
+	throw std::invalid_argument(what);
+}
+
+constexpr pattern_charset escape_class(char c)
+{
+	pattern_charset set;
+	switch ( c ) {
+	case 'd': case 'D':
+		set.add('0', '9');
+		break;
+	case 'w': case 'W':
+		set.add('a', 'z'); set.add('A', 'Z'); set.add('0', '9'); set.add('_');
+		break;
+	case 's': case 'S':
+		set.add(' '); set.add('\t'); set.add('\n'); set.add('\r'); set.add('\f'); set.add('\v');
+		break;
+	default:
+		set.add(static_cast<unsigned char>(c));
+		return set;
+	}
+	if ( c >= 'A' && c <= 'Z' )
+		set.invert();
+	return set;
+}
+
+constexpr std::size_t parse_number(char const* p, std::size_t n, std::size_t& i)
+{
+	if ( i >= n || p[i] < '0' || p[i] > '9' )
+		pattern_error("expected a number");
+	std::size_t value = 0;
+	while ( i < n && p[i] >= '0' && p[i] <= '9' )
+		value = value * 10 + (p[i++] - '0');
+	return value;
+}
+
+constexpr pattern_nfa parse_pattern(char const* p, std::size_t n)
+{
+	pattern_nfa nfa;
+	std::size_t i = 0;
+	while ( i < n ) {
+		// atom
+		pattern_charset set;
+		char const c = p[i++];
+		if ( c == '\\' ) {
+			if ( i >= n )
+				pattern_error("trailing backslash");
+			set = escape_class(p[i++]);
+		}
+		else if ( c == '.' ) {
+			set.invert();
+		}
+		else if ( c == '[' ) {
+			bool const negate = i < n && p[i] == '^';
+			if ( negate )
+				++i;
+			bool first = true;
+			while ( i < n && (p[i] != ']' || first) ) {
+				first = false;
+				char lo = p[i++];
+				if ( lo == '\\' && i < n ) {
+					char const e = p[i++];
+					if ( e == 'd' || e == 'w' || e == 's' || e == 'D' || e == 'W' || e == 'S' ) {
+						set.add(escape_class(e));
+						continue;
+					}
+					lo = e;
+				}
+				if ( i + 1 < n && p[i] == '-' && p[i + 1] != ']' ) {
+					char hi = p[i + 1];
+					i += 2;
+					if ( hi == '\\' && i < n )
+						hi = p[i++];
+					if ( static_cast<unsigned char>(hi) < static_cast<unsigned char>(lo) )
+						pattern_error("reversed range");
+					set.add(static_cast<unsigned char>(lo), static_cast<unsigned char>(hi));
+				}
+				else {
+					set.add(static_cast<unsigned char>(lo));
+				}
+			}
+			if ( i >= n )
+				pattern_error("unterminated character class");
+			++i; // ]
+			if ( negate )
+				set.invert();
+		}
+		else if ( c == '*' || c == '+' || c == '?' || c == '{' || c == '(' || c == ')' || c == '|' ) {
+			pattern_error("unsupported or misplaced operator");
+		}
+		else {
+			set.add(static_cast<unsigned char>(c));
+		}
+
+		// quantifier
+		std::size_t min = 1, max = 1;
+		bool unbounded = false;
+		if ( i < n ) {
+			if ( p[i] == '?' )      { min = 0; ++i; }
+			else if ( p[i] == '*' ) { min = 0; unbounded = true; ++i; }
+			else if ( p[i] == '+' ) { unbounded = true; ++i; }
+			else if ( p[i] == '{' ) {
+				++i;
+				min = max = parse_number(p, n, i);
+				if ( i < n && p[i] == ',' ) {
+					++i;
+					if ( i < n && p[i] == '}' )
+						unbounded = true;
+					else
+						max = parse_number(p, n, i);
+				}
+				if ( i >= n || p[i] != '}' || max < min )
+					pattern_error("bad repetition");
+				++i;
+			}
+		}
+
+		// expand into positions
+		std::size_t const copies = unbounded ? (min == 0 ? 1 : min) : max;
+		if ( nfa.count + copies > pattern_nfa::max_positions )
+			pattern_error("pattern too long");
+		for (std::size_t k = 0; k < copies; ++k) {
+			pattern_position& pos = nfa.positions[nfa.count++];
+			pos.chars = set;
+			pos.optional = k >= min;
+			pos.loop = unbounded && k + 1 == copies;
+		}
+	}
+	return nfa;
+}
+
+// bytes that no position tells apart share a class
+struct pattern_classes {
+	std::uint8_t  of[256] = {};
+	unsigned char representative[256] = {};
+	std::size_t   count = 0;
+};
+
+constexpr pattern_classes make_pattern_classes(pattern_nfa const& nfa)
+{
+	pattern_classes classes;
+	std::uint64_t signature[256] = {};
+	for (unsigned c = 0; c < 256; ++c) {
+		std::uint64_t sig = 0;
+		for (std::size_t p = 0; p < nfa.count; ++p)
+			if ( nfa.positions[p].chars.has(static_cast<unsigned char>(c)) )
+				sig |= std::uint64_t(1) << p;
+		signature[c] = sig;
+
+		std::size_t k = 0;
+		while ( k < classes.count && signature[classes.representative[k]] != sig )
+			++k;
+		if ( k == classes.count )
+			classes.representative[classes.count++] = static_cast<unsigned char>(c);
+		classes.of[c] = static_cast<std::uint8_t>(k);
+	}
+	return classes;
+}
+
+constexpr std::uint64_t pattern_step(pattern_nfa const& nfa, std::uint64_t states, unsigned char c)
+{
+	std::uint64_t next = 0;
+	for (std::size_t b = 0; b <= nfa.count; ++b) {
+		if ( !((states >> b) & 1) )
+			continue;
+		// b == 0 is the start state, otherwise position b - 1 was just matched
+		if ( b > 0 && nfa.positions[b - 1].loop && nfa.positions[b - 1].chars.has(c) )
+			next |= std::uint64_t(1) << b;
+		for (std::size_t q = b; q < nfa.count; ++q) {
+			if ( nfa.positions[q].chars.has(c) )
+				next |= std::uint64_t(1) << (q + 1);
+			if ( !nfa.positions[q].optional )
+				break;
+		}
+	}
+	return next;
+}
+
+constexpr bool pattern_accepts(pattern_nfa const& nfa, std::uint64_t states)
+{
+	for (std::size_t b = 0; b <= nfa.count; ++b) {
+		if ( !((states >> b) & 1) )
+			continue;
+		std::size_t q = b;
+		while ( q < nfa.count && nfa.positions[q].optional )
+			++q;
+		if ( q == nfa.count )
+			return true;
+	}
+	return false;
+}
+
+// subset construction; state 0 is dead and state 1 is the start
+template <class OnEdge>
+constexpr std::size_t pattern_subsets(pattern_nfa const& nfa, pattern_classes const& classes,
+	std::uint64_t (&sets)[256], OnEdge on_edge)
+{
+	std::size_t count = 2;
+	sets[0] = 0;
+	sets[1] = 1;
+	for (std::size_t s = 1; s < count; ++s) {
+		for (std::size_t k = 0; k < classes.count; ++k) {
+			std::uint64_t const next = pattern_step(nfa, sets[s], classes.representative[k]);
+			std::size_t t = 0;
+			while ( t < count && sets[t] != next )
+				++t;
+			if ( t == count ) {
+				if ( count == 256 )
+					pattern_error("pattern needs too many DFA states");
+				sets[count++] = next;
+			}
+			on_edge(s, k, t);
+		}
+	}
+	return count;
+}
+
+constexpr std::size_t pattern_state_count(pattern_nfa const& nfa, pattern_classes const& classes)
+{
+	std::uint64_t sets[256] = {};
+	return pattern_subsets(nfa, classes, sets, [](std::size_t, std::size_t, std::size_t) { });
+}
+
+template <std::size_t States, std::size_t Classes>
+struct pattern_dfa {
+	std::uint8_t next[States][Classes] = {};
+	bool         accept[States] = {};
+};
+
+template <std::size_t States, std::size_t Classes>
+constexpr pattern_dfa<States, Classes> build_pattern_dfa(pattern_nfa const& nfa, pattern_classes const& classes)
+{
+	pattern_dfa<States, Classes> dfa;
+	std::uint64_t sets[256] = {};
+	pattern_subsets(nfa, classes, sets, [&](std::size_t s, std::size_t k, std::size_t t) {
+		dfa.next[s][k] = static_cast<std::uint8_t>(t);
+	});
+	for (std::size_t s = 0; s < States; ++s)
+		dfa.accept[s] = pattern_accepts(nfa, sets[s]);
+	return dfa;
+}
+
+template <fixed_string pattern>
+struct compiled_pattern {
+	static constexpr pattern_nfa     nfa     = parse_pattern(pattern.value, pattern.size());
+	static constexpr pattern_classes classes = make_pattern_classes(nfa);
+	static constexpr std::size_t     states  = pattern_state_count(nfa, classes);
+	static constexpr pattern_dfa<states, classes.count> dfa =
+		build_pattern_dfa<states, classes.count>(nfa, classes);
+
+	static bool match(char const* str, std::size_t size)
+	{
+		std::uint8_t state = 1;
+		for (std::size_t i = 0; i < size; ++i) {
+			state = dfa.next[state][classes.of[static_cast<unsigned char>(str[i])]];
+			if ( state == 0 )
+				return false;
+		}
+		return dfa.accept[state];
+	}
+};
+
+} // namespace safe_detail
+
+
+template <class T, fixed_string pattern>
+struct pattern_exception : public std::invalid_argument {
+	typedef std::invalid_argument base;
+	typedef T value_type;
+	typedef typename safe_detail::types<T>::argument_type argument_type;
+
+	explicit pattern_exception(argument_type data) : base(pattern_msg(data)) { }
+
+	static std::string pattern_msg(argument_type data)
+	{
+		std::ostringstream ss;
+		ss  << "The value \"";
+		safe_detail::write_prefix(ss, data, 32);
+		ss  << "\" does not match " << pattern.value << '.';
+		return ss.str();
+	}
+};
+
+// pattern validations for strings and string views
+template <class T, fixed_string pattern, class exception = pattern_exception<T, pattern> >
+struct pattern_validation {
+	typedef exception exception_type;
+	typedef typename safe_detail::types<T>::argument_type argument_type;
+	typedef safe_detail::compiled_pattern<pattern> compiled_type;
+
+	static inline bool is_valid(argument_type str)
+	{ return compiled_type::match(str.data(), str.size()); }
+	static inline void validate(argument_type str)
+	{
+		if ( !is_valid(str) )
+			throw exception_type(str);
+	}
+};
+
+} // namespace safe_data
+
+#endif
@@ -0,0 +1,186 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/record.h
+
+Created: 2026.10.18
+
+Description:
+	Records of safe<> fields with cross-field invariants. Each invariant names
+	the fields it reads, so a change re-runs only the invariants that depend
+	on the changed fields. A batch of updates is applied atomically: either
+	every field changes and all affected invariants hold, or the record is
+	left as it was.
+
+		enum { start, end };
+		struct ordered {
+			typedef depends_on<start, end> fields;
+			template <class R> static void validate(R const& r)
+			{ if ( r.template get<end>() < r.template get<start>() ) throw ...; }
+		};
+		typedef safe_record<std::tuple<safe_int, safe_int>, ordered> span_record;
+*/
+
+#ifndef SAFE_DATA_RECORD_MPN_18OCT2026_HPP
+#define SAFE_DATA_RECORD_MPN_18OCT2026_HPP
+
+#include "safe_data/safe_fwd.h"
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <tuple>
+
+namespace safe_data {
+
+typedef unsigned long long field_mask;
+
+// fields an invariant reads, by index into the record
+template <std::size_t... fields> struct depends_on;
+
+template <> struct depends_on<> {
+	static field_mask const value = 0;
+};
+
+template <std::size_t field, std::size_t... rest>
+struct depends_on<field, rest...> {
+	static_assert(field < 64, "safe_record supports at most 64 fields");
+	static field_mask const value = (field_mask(1) << field) | depends_on<rest...>::value;
+};
+
+namespace safe_detail {
+
+template <class... Invariants> struct check_invariants;
+
+template <> struct check_invariants<> {
+	template <class Record>
+	static void apply(Record const&, field_mask) { }
+};
+
+template <class Invariant, class... Rest>
+struct check_invariants<Invariant, Rest...> {
+	template <class Record>
+	static void apply(Record const& r, field_mask changed)
+	{
+		if ( Invariant::fields::value & changed )
+			Invariant::validate(r);
+		check_invariants<Rest...>::apply(r, changed);
+	}
+};
+
+// swaps staged values in and out of a record's fields
+template <std::size_t N, std::size_t Count>
+struct swap_staged {
+	template <class Fields, class Staged>
+	static void apply(Fields& fields, Staged& staged, field_mask mask)
+	{
+		if ( mask & (field_mask(1) << N) )
+			std::get<N>(fields).swap(*std::get<N>(staged));
+		swap_staged<N + 1, Count>::apply(fields, staged, mask);
+	}
+};
+
+template <std::size_t Count>
+struct swap_staged<Count, Count> {
+	template <class Fields, class Staged>
+	static void apply(Fields&, Staged&, field_mask) { }
+};
+
+} // namespace safe_detail
+
+
+template <class Fields, class... Invariants> class safe_record;
+
+// safe_record - throws the invariant's exception when a change breaks it
+template <class... Fields, class... Invariants>
+class safe_record<std::tuple<Fields...>, Invariants...> {
+	static_assert(sizeof...(Fields) <= 64, "safe_record supports at most 64 fields");
+public:
+	typedef std::tuple<Fields...> fields_type;
+	static std::size_t const field_count = sizeof...(Fields);
+	static field_mask const all_fields =
+		field_count == 64 ? ~field_mask(0) : (field_mask(1) << field_count) - 1;
+
+	template <std::size_t N>
+	struct field { typedef typename std::tuple_element<N, fields_type>::type type; };
+
+	safe_record() : fields_(), changed_(0) { validate(); }
+	explicit safe_record(Fields const&... fields) : fields_(fields...), changed_(0) { validate(); }
+
+// access
+	template <std::size_t N>
+	typename field<N>::type const& get() const { return std::get<N>(fields_); }
+
+	fields_type const& fields() const { return fields_; }
+
+	void validate() const { safe_detail::check_invariants<Invariants...>::apply(*this, all_fields); }
+
+// change tracking
+	field_mask changed() const { return changed_; }
+	bool changed(std::size_t n) const { return (changed_ >> n) & 1; }
+	void clear_changed() { changed_ = 0; }
+
+// modify a single field; rolled back when a dependent invariant fails
+	template <std::size_t N, class U>
+	void set(U const& value)
+	{
+		typename field<N>::type updated(value);
+		std::get<N>(fields_).swap(updated);
+		try {
+			safe_detail::check_invariants<Invariants...>::apply(*this, field_mask(1) << N);
+		}
+		catch (...) {
+			std::get<N>(fields_).swap(updated);
+			throw;
+		}
+		changed_ |= field_mask(1) << N;
+	}
+
+// batch of field changes, validated together on commit()
+	class update {
+	public:
+		explicit update(safe_record& record) : record_(&record), staged_(), mask_(0) { }
+
+		// the field itself is validated here
+		template <std::size_t N, class U>
+		update& set(U const& value)
+		{
+			std::get<N>(staged_) = typename field<N>::type(value);
+			mask_ |= field_mask(1) << N;
+			return *this;
+		}
+
+		field_mask staged() const { return mask_; }
+
+		void commit()
+		{
+			safe_detail::swap_staged<0, field_count>::apply(record_->fields_, staged_, mask_);
+			try {
+				safe_detail::check_invariants<Invariants...>::apply(*record_, mask_);
+			}
+			catch (...) {
+				safe_detail::swap_staged<0, field_count>::apply(record_->fields_, staged_, mask_);
+				throw;
+			}
+			record_->changed_ |= mask_;
+			staged_ = std::tuple<boost::optional<Fields>...>();
+			mask_ = 0;
+		}
+
+	private:
+		safe_record*                            record_;
+		std::tuple<boost::optional<Fields>...>  staged_;
+		field_mask                              mask_;
+	};
+
+	update begin_update() { return update(*this); }
+
+private:
+	fields_type fields_;
+	field_mask  changed_;
+};
+
+} // namespace safe_data
+
+#endif
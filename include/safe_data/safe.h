@@ -18,6 +18,12 @@ Description:
 
 #include <boost/swap.hpp>
 
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
 namespace safe_data {
 
 
@@ -32,6 +38,15 @@ public:
 };
 
 
+// tag for constructing from data that has already been validated
+struct unchecked_t { };
+#if __cplusplus >= 201703L
+inline constexpr unchecked_t unchecked = unchecked_t();   // external linkage, so modules can export it
+#else
+static unchecked_t const unchecked = unchecked_t();
+#endif
+
+
 // data validation
 template <class T> class no_validation {
 public:
@@ -42,6 +57,13 @@ public:
 
 
 // safe - throws an exception when new data does not pass validation
+//
+// A moved-from safe<> is still valid: when the value the move left behind
+// fails is_valid(), such as the empty vector of a validation that needs at
+// least one element, it is reset to the initial value. The check never
+// throws, so a move is noexcept whenever the raw type's move is. Validations
+// without is_valid() are not checked after a move. Such a moved-from value,
+// or one whose reset failed, may only be assigned to or destroyed.
 template <class T, class validation_attributes, class initial_value>
 class safe {
 	typedef typename safe_detail::types<T> types;
@@ -57,6 +79,7 @@ public:
 	typedef typename types::pointer_type         pointer_type;
 	typedef typename types::pointer_const_type   pointer_const_type;
 	typedef typename types::argument_type        argument_type;
+	typedef typename types::rvalue_type          rvalue_type;
 
 // self
 	safe() : data_(initial_type())
@@ -68,9 +91,24 @@ public:
 	safe(safe const& rhs) : data_(rhs.data_) { }
 	safe& operator= (safe const& rhs) { data_ = rhs.data_; return *this; }
 
+	safe(safe&& rhs) noexcept(std::is_nothrow_move_constructible<storage_type>::value) :
+		data_(static_cast<storage_type&&>(rhs.data_))
+	{ rhs.restore_after_move(moves_by_copy()); }
+	safe& operator= (safe&& rhs) noexcept(std::is_nothrow_move_assignable<storage_type>::value)
+	{
+		data_ = static_cast<storage_type&&>(rhs.data_);
+		if ( &rhs != this )
+			rhs.restore_after_move(moves_by_copy());
+		return *this;
+	}
+
 // data
 	safe(argument_type data) : data_(do_validation(data)) { }
+	safe(unchecked_t, argument_type data) : data_(data) { } // caller guarantees data is valid
+	safe(unchecked_t, rvalue_type data) : data_(std::move(data)) { }
 	safe& operator= (argument_type data) { data_ = do_validation(data); return *this; }
+	safe(rvalue_type data) : data_(do_validation(std::move(data))) { }
+	safe& operator= (rvalue_type data) { data_ = do_validation(std::move(data)); return *this; }
 
 // similar types
 	template <class U>
@@ -84,6 +122,35 @@ public:
 	template <class U, class V, class I>
 	safe& operator= (safe<U,V,I> const& rhs) { data_ = do_validation(rhs.data()); return *this; }
 
+// uses-allocator construction, for strings and containers
+	template <class Alloc>
+	safe(std::allocator_arg_t, Alloc const& a) : data_(raw_type(initial_type()), a)
+	{
+		#ifndef NDEBUG
+		validation_type::validate(data_);
+		#endif
+	}
+	template <class Alloc>
+	safe(std::allocator_arg_t, Alloc const& a, safe const& rhs) : data_(rhs.data_, a) { }
+	template <class Alloc>
+	safe(std::allocator_arg_t, Alloc const& a, safe&& rhs) : data_(static_cast<storage_type&&>(rhs.data_), a)
+	{ rhs.restore_after_move(moves_by_copy()); }
+	template <class Alloc>
+	safe(std::allocator_arg_t, Alloc const& a, argument_type data) : data_(do_validation(data), a) { }
+	template <class Alloc>
+	safe(std::allocator_arg_t, Alloc const& a, rvalue_type data) : data_(do_validation(std::move(data)), a) { }
+	template <class Alloc, class U>
+	safe(std::allocator_arg_t, Alloc const& a, U const& data) : data_(do_validation(raw_type(data, a))) { }
+
+	template <class R = raw_type>
+	typename R::allocator_type get_allocator() const { return data_.get_allocator(); }
+
+// lazy expressions - validated once, see expression.h
+	template <class E>
+	safe(expression<E> const& e) : data_(e.template assign_to<safe>()) { }
+	template <class E>
+	safe& operator= (expression<E> const& e) { data_ = e.template assign_to<safe>(); return *this; }
+
 	void swap(safe& other)
 	{
 		boost::swap(data_, other.data_);
@@ -130,10 +197,161 @@ public:
 		return s;
 	}
 
+// in-place modification - validated afterwards and rolled back on failure
+	template <class F>
+	safe& modify(F f)
+	{
+		raw_type previous(safe_detail::clone<raw_type>(data_));
+		try {
+			f(static_cast<reference_type>(data_));
+			validation_type::validate(data_);
+		}
+		catch (...) {
+			boost::swap(static_cast<reference_type>(data_), previous);
+			throw;
+		}
+		return *this;
+	}
+
+// container forwarding - size-only validations are checked before the change
+	template <class U>
+	void push_back(U&& value)
+	{
+		check_size(data_.size() + 1, size_only());
+		data_.push_back(std::forward<U>(value));
+		check_after(size_only(), [&] { data_.pop_back(); });
+	}
+
+	template <class... Args>
+	void emplace_back(Args&&... args)
+	{
+		check_size(data_.size() + 1, size_only());
+		data_.emplace_back(std::forward<Args>(args)...);
+		check_after(size_only(), [&] { data_.pop_back(); });
+	}
+
+	template <class Iter, class U, class R = raw_type>
+	auto insert(Iter pos, U&& value)
+		-> decltype(std::declval<R&>().insert(pos, std::forward<U>(value)))
+	{
+		check_size(data_.size() + 1, size_only());
+		auto it = data_.insert(pos, std::forward<U>(value));
+		check_after(size_only(), [&] { data_.erase(it); });
+		return it;
+	}
+
+	template <class Iter, class R = raw_type>
+	auto erase(Iter pos) -> decltype(std::declval<R&>().erase(pos))
+	{
+		check_size(data_.size() - 1, size_only());
+		return erase_with_rollback(pos, std::next(pos), size_only());
+	}
+
+	template <class Iter, class R = raw_type>
+	auto erase(Iter first, Iter last) -> decltype(std::declval<R&>().erase(first, last))
+	{
+		typedef typename raw_type::const_iterator const_iterator;
+		std::size_t const count = std::distance(const_iterator(first), const_iterator(last));
+		check_size(data_.size() - count, size_only());
+		return erase_with_rollback(first, last, size_only());
+	}
+
+	void resize(std::size_t size)
+	{
+		check_size(size, size_only());
+		resize_with_rollback(size, size_only(), [&] { data_.resize(size); });
+	}
+
+	template <class U>
+	void resize(std::size_t size, U const& value)
+	{
+		check_size(size, size_only());
+		resize_with_rollback(size, size_only(), [&] { data_.resize(size, value); });
+	}
+
+	void reserve(std::size_t capacity) { data_.reserve(capacity); }
+
 	static reference_const_type do_validation(reference_const_type data)
 	{ validation_type::validate(data); return data; }
+	static rvalue_type do_validation(rvalue_type data)
+	{ validation_type::validate(data); return std::move(data); }
 
 private:
+	typedef std::integral_constant<bool,
+		safe_detail::has_validate_size<validation_type>::value> size_only;
+
+	// a move that copies leaves the source as it was
+	typedef std::integral_constant<bool,
+		std::is_reference<T>::value || std::is_trivially_copyable<raw_type>::value> moves_by_copy;
+
+	void restore_after_move(std::true_type) noexcept { }
+	void restore_after_move(std::false_type) noexcept
+	{
+		if ( !holds_valid(std::integral_constant<bool, safe_detail::has_is_valid<validation_type, raw_type>::value>()) )
+			reset_to_initial(std::integral_constant<bool, std::is_constructible<raw_type, initial_type>::value>());
+	}
+
+	bool holds_valid(std::true_type) const noexcept { return validation_type::is_valid(data_); }
+	bool holds_valid(std::false_type) const noexcept { return true; } // only validate() could tell, and it throws
+
+	// a reset that cannot allocate leaves the moved-from value
+	void reset_to_initial(std::true_type) noexcept
+	{
+		try {
+			data_ = raw_type(initial_type());
+		}
+		catch (...) { }
+	}
+	void reset_to_initial(std::false_type) noexcept { }
+
+	void check_size(std::size_t size, std::true_type) const { validation_type::validate_size(size); }
+	void check_size(std::size_t, std::false_type) const { }
+
+	template <class Undo>
+	void check_after(std::true_type, Undo) const { }
+	template <class Undo>
+	void check_after(std::false_type, Undo undo)
+	{
+		try {
+			validation_type::validate(data_);
+		}
+		catch (...) {
+			undo();
+			throw;
+		}
+	}
+
+	// only a validation of the contents needs a copy of what was erased
+	template <class Iter, class R = raw_type>
+	typename R::iterator erase_with_rollback(Iter first, Iter last, std::true_type)
+	{ return data_.erase(first, last); }
+	template <class Iter, class R = raw_type>
+	typename R::iterator erase_with_rollback(Iter first, Iter last, std::false_type)
+	{
+		typedef typename R::const_iterator const_iterator;
+		R saved(first, last, data_.get_allocator());
+		std::size_t const index = std::distance(data_.cbegin(), const_iterator(first));
+		typename R::iterator it = data_.erase(first, last);
+		check_after(std::false_type(), [&] { data_.insert(std::next(data_.begin(), index), saved.begin(), saved.end()); });
+		return it;
+	}
+
+	template <class Resize>
+	void resize_with_rollback(std::size_t, std::true_type, Resize resize) { resize(); }
+	template <class Resize>
+	void resize_with_rollback(std::size_t size, std::false_type, Resize resize)
+	{
+		std::size_t const old_size = data_.size();
+		raw_type tail(data_.get_allocator());
+		if ( size < old_size )
+			tail.assign(std::next(data_.begin(), size), data_.end());
+		resize();
+		check_after(std::false_type(), [&] {
+			data_.resize(old_size < size ? old_size : size);
+			data_.insert(data_.end(), tail.begin(), tail.end());
+		});
+	}
+
 	storage_type data_;
 };
 
@@ -142,4 +360,13 @@ typename safe<T,V,I>::reference_const_type get(safe<T,V,I> const& s) { return s.
 
 } // namespace safe_data
 
+
+namespace std {
+
+template <class T, class V, class I, class Alloc>
+struct uses_allocator<safe_data::safe<T,V,I>, Alloc> :
+	uses_allocator<typename safe_data::safe<T,V,I>::raw_type, Alloc> { };
+
+} // namespace std
+
 #endif
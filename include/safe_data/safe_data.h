@@ -13,6 +13,8 @@ Description:
 	Can validate ranges, minimums, maximums, string length, and container sizes.
 	safe_data is designed to work well with the C++ Boost Libraries.
 
+	The headers added since are not included here; include them one by
+	one, or include safe_data_all.h for everything.
 */
 
 #ifndef SAFE_DATA_MPN_14MAY2006_HPP
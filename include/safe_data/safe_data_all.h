@@ -0,0 +1,58 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data_all.h
+
+Created: 2026.10.18
+
+Description:
+	Includes every safe_data header: safe_data.h, plus the opt-in headers
+	for character sets, floating point, levels, sets of values and
+	patterns, lazy expressions, deferred, collecting, asynchronous,
+	parallel and memoized validation, shared and interned values, records,
+	indexes, hashing, sorting, spans, tokenizing and memory-mapped arrays.
+	These pull in <thread>, <future>, Boost hashing and more of the
+	standard library, so they roughly double the cost of safe_data.h in
+	every translation unit; see samples/build_timing.sh.
+*/
+
+#ifndef SAFE_DATA_ALL_MPN_18OCT2026_HPP
+#define SAFE_DATA_ALL_MPN_18OCT2026_HPP
+
+#include "safe_data/safe_data.h"
+
+#include "safe_data/levels.h"
+#include "safe_data/charset.h"
+#include "safe_data/collect.h"
+#include "safe_data/deferred.h"
+#include "safe_data/expression.h"
+#include "safe_data/floating.h"
+#include "safe_data/index.h"
+#include "safe_data/shared.h"
+#include "safe_data/async.h"
+#include "safe_data/hash.h"
+#include "safe_data/interned.h"
+#include "safe_data/memoized.h"
+#include "safe_data/parallel.h"
+#include "safe_data/record.h"
+#include "safe_data/sort.h"
+#include "safe_data/span.h"
+
+#if __cplusplus >= 201402L
+#include "safe_data/one_of.h"
+#endif
+
+#if __cplusplus >= 201703L
+#include "safe_data/tokenizer.h"
+#endif
+
+#if __cplusplus >= 202002L
+#include "safe_data/pattern.h"
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include "safe_data/mapped_array.h"
+#endif
+
+#endif
@@ -18,8 +18,16 @@ Description:
 #include "boost/mpl/if.hpp"
 
 #include <type_traits>
+#include <utility>
 
 namespace safe_data {
+
+template <class T>
+struct is_safe : std::false_type { };
+
+template <class T, class V, class I>
+struct is_safe<safe<T,V,I> > : std::true_type { };
+
 namespace safe_detail {
 
 template<class T>
@@ -32,8 +40,12 @@ struct not_ref_types {
 	typedef T const* pointer_const_type;
 	typedef T      * pointer_type;
 	typedef T const& argument_type;
+	typedef T     && rvalue_type;
 };
 
+// references are never moved from
+struct no_rvalue { };
+
 template<class T>
 struct ref_types {
 	typedef typename std::remove_reference<T>::type raw_type;
@@ -44,6 +56,7 @@ struct ref_types {
 	typedef raw_type * pointer_const_type;
 	typedef raw_type * pointer_type;
 	typedef raw_type & argument_type;
+	typedef no_rvalue&& rvalue_type;
 };
 
 template <class T>
@@ -69,8 +82,52 @@ struct types {
     typedef typename selected_types::pointer_const_type pointer_const_type;
     typedef typename selected_types::pointer_type pointer_type;
     typedef typename selected_types::argument_type argument_type;
+    typedef typename selected_types::rvalue_type rvalue_type;
+};
+
+// validations with validate_size(n) depend on nothing but the size
+template <class V>
+struct has_validate_size {
+	template <class U> static char test(decltype(&U::validate_size));
+	template <class U> static long test(...);
+	static bool const value = sizeof(test<V>(0)) == sizeof(char);
+};
+
+// validations with is_valid(data) can be checked without throwing; A is the data type
+template <class V, class A>
+struct has_is_valid {
+	template <class U> static char test(decltype(U::is_valid(std::declval<A const&>()))*);
+	template <class U> static long test(...);
+	static bool const value = sizeof(test<V>(0)) == sizeof(char);
+};
+
+// containers and strings with an allocator_type and get_allocator()
+template <class T>
+struct has_allocator {
+	template <class U> static char test(typename U::allocator_type*, decltype(&U::get_allocator));
+	template <class U> static long test(...);
+	static bool const value = sizeof(test<T>(0, 0)) == sizeof(char);
 };
 
+// data as an rvalue, except for safe<T&>, which only assigns from lvalues
+template <class T, class R>
+inline typename std::conditional<std::is_reference<T>::value, R&, R&&>::type move_unless_ref(R& data)
+{ return static_cast<typename std::conditional<std::is_reference<T>::value, R&, R&&>::type>(data); }
+
+// a copy that keeps the allocator of the original
+template <class T>
+inline T clone(T const& data, std::true_type) { return T(data, data.get_allocator()); }
+
+template <class T>
+inline T clone(T const& data, std::false_type) { return data; }
+
+template <class T>
+inline T clone(T const& data) { return clone(data, std::integral_constant<bool, has_allocator<T>::value>()); }
+
+// R for an operator with a raw operand Y, when Y is not a safe<> and E is a valid expression
+template <class Y, class R, class E>
+struct raw_operand : std::enable_if<!is_safe<Y>::value, R> { };
+
 } // namespace safe_detail
 } // namespace safe_data
 
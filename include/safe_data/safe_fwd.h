@@ -29,6 +29,9 @@ template <
 >
 class safe;
 
+// lazy expression over safe<>, see expression.h
+template <class E> class expression;
+
 } // namespace safe_data
 
 
@@ -0,0 +1,164 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/shared.h
+
+Created: 2026.10.18
+
+Description:
+	Copy-on-write storage for large values that are rarely modified, such
+	as configuration blobs and lookup tables. A shared_safe keeps its
+	validated value in one immutable, reference-counted payload. Copies
+	share the payload: copying is a pointer copy and an atomic increment,
+	and nothing is validated again.
+
+		typedef shared_safe<std::vector<int>, size_validation<std::vector<int>, size_t<1024> > > table;
+		table a(values);   // validated once
+		table b(a);        // shares a's payload
+		b.modify([](std::vector<int>& v) { v.push_back(1); });   // b detaches; a is unchanged
+
+	Assignment and modify() validate the new value before it replaces the
+	payload, so a failed change leaves the value as it was. modify() on a
+	shared payload works on a copy; a payload that is not shared is changed
+	in place and rolled back if the change fails. Moving a shared_safe
+	shares the payload like a copy, so a moved-from object keeps its value.
+
+	Copies may be read from any number of threads. modify() needs exclusive
+	access to the object it is called on: no other thread may read or copy
+	that object during the call. Other copies of the payload may still be
+	used concurrently.
+*/
+
+#ifndef SAFE_DATA_SHARED_MPN_18OCT2026_HPP
+#define SAFE_DATA_SHARED_MPN_18OCT2026_HPP
+
+#include "safe_data/safe.h"
+
+#include <atomic>
+#include <iosfwd>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace safe_data {
+
+// shared_safe - throws an exception when new data does not pass validation
+template <class T, class validation = no_validation<T>, class initial_value = T>
+class shared_safe {
+	static_assert(!std::is_reference<T>::value, "shared_safe needs a value type");
+public:
+	typedef T                                 value_type;
+	typedef validation                        validation_type;
+	typedef initial_value                     initial_type;
+	typedef safe<T, validation, initial_value> safe_type;
+
+	typedef T        raw_type;
+	typedef T const& reference_const_type;
+	typedef T const& argument_type;
+
+// self
+	shared_safe() : data_(std::make_shared<raw_type>(initial_type()))
+	{
+		#ifndef NDEBUG
+		validation_type::validate(*data_);
+		#endif
+	}
+	shared_safe(shared_safe const& rhs) : data_(rhs.data_) { }
+	shared_safe& operator= (shared_safe const& rhs) { data_ = rhs.data_; return *this; }
+
+	// a move is a copy, so the source never loses its payload
+	shared_safe(shared_safe&& rhs) noexcept : data_(rhs.data_) { }
+	shared_safe& operator= (shared_safe&& rhs) noexcept { data_ = rhs.data_; return *this; }
+
+// data
+	shared_safe(argument_type data) : data_(make_payload(do_validation(data))) { }
+	shared_safe(raw_type&& data) : data_() { validation_type::validate(data); data_ = make_payload(std::move(data)); }
+	shared_safe(unchecked_t, argument_type data) : data_(make_payload(data)) { } // caller guarantees data is valid
+	shared_safe& operator= (argument_type data) { data_ = make_payload(do_validation(data)); return *this; }
+
+// safe data of the same type - already valid
+	explicit shared_safe(safe_type const& rhs) : data_(make_payload(rhs.data())) { }
+	safe_type to_safe() const { return safe_type(unchecked, *data_); }
+
+// access
+	operator reference_const_type     () const { return *data_; }
+	         reference_const_type data() const { return *data_; }
+	raw_type const*        operator-> () const { return data_.get(); }
+
+	void validate() const { validation_type::validate(*data_); }
+
+	// number of shared_safe objects sharing the payload
+	long use_count() const { return data_.use_count(); }
+	bool shares_with(shared_safe const& other) const { return data_ == other.data_; }
+
+	void swap(shared_safe& other) { data_.swap(other.data_); }
+
+// copy-on-write modification - validated before the change is kept
+	template <class F>
+	shared_safe& modify(F f)
+	{
+		if ( data_.use_count() != 1 ) {
+			raw_type work(*data_);
+			f(work);
+			validation_type::validate(work);
+			data_ = make_payload(std::move(work));
+			return *this;
+		}
+		// use_count() is a relaxed load; pairs with the release of the last other copy
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		raw_type& data = const_cast<raw_type&>(*data_);
+		raw_type previous(safe_detail::clone<raw_type>(data));
+		try {
+			f(data);
+			validation_type::validate(data);
+		}
+		catch (...) {
+			boost::swap(data, previous);
+			throw;
+		}
+		return *this;
+	}
+
+	static reference_const_type do_validation(reference_const_type data)
+	{ validation_type::validate(data); return data; }
+
+private:
+	// the payload is created mutable, so an unshared payload may be written through const_cast
+	template <class U>
+	static std::shared_ptr<raw_type const> make_payload(U&& data)
+	{ return std::make_shared<raw_type>(std::forward<U>(data)); }
+
+	std::shared_ptr<raw_type const> data_;
+};
+
+template <class T, class V, class I>
+inline bool operator== (shared_safe<T,V,I> const& lhs, shared_safe<T,V,I> const& rhs)
+{ return lhs.shares_with(rhs) || lhs.data() == rhs.data(); }
+
+template <class T, class V, class I>
+inline bool operator!= (shared_safe<T,V,I> const& lhs, shared_safe<T,V,I> const& rhs)
+{ return !(lhs == rhs); }
+
+template <class T, class V, class I>
+inline bool operator< (shared_safe<T,V,I> const& lhs, shared_safe<T,V,I> const& rhs)
+{ return !lhs.shares_with(rhs) && lhs.data() < rhs.data(); }
+
+template <class T, class V, class I, class Elem, class Traits>
+inline std::basic_ostream<Elem, Traits>&
+	operator<< (
+		std::basic_ostream<Elem, Traits>& out,
+		shared_safe<T,V,I> const& s
+	)
+{
+	out << s.data();
+	return out;
+}
+
+template <class T, class V, class I>
+typename shared_safe<T,V,I>::reference_const_type get(shared_safe<T,V,I> const& s) { return s.data(); }
+
+} // namespace safe_data
+
+#endif
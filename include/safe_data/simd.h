@@ -0,0 +1,68 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/simd.h
+
+Created: 2026.10.18
+
+Description:
+	Instruction set detection for the vectorized validations. Defines
+	SAFE_DATA_SSE2 and SAFE_DATA_AVX2 when the compiler targets them. Define
+	SAFE_DATA_NO_SIMD to use the portable code instead.
+*/
+
+#ifndef SAFE_DATA_SIMD_MPN_18OCT2026_HPP
+#define SAFE_DATA_SIMD_MPN_18OCT2026_HPP
+
+#if !defined(SAFE_DATA_NO_SIMD)
+#if defined(__AVX2__)
+#define SAFE_DATA_AVX2
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SAFE_DATA_SSE2
+#include <emmintrin.h>
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace safe_data {
+namespace safe_detail {
+
+// index of the lowest set bit; mask must not be 0
+inline unsigned trailing_zeros(unsigned mask)
+{
+#if defined(__GNUC__)
+	return __builtin_ctz(mask);
+#elif defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return index;
+#else
+	unsigned n = 0;
+	while ( !(mask & 1) ) {
+		mask >>= 1;
+		++n;
+	}
+	return n;
+#endif
+}
+
+inline unsigned trailing_zeros(unsigned long long mask)
+{
+#if defined(__GNUC__)
+	return __builtin_ctzll(mask);
+#else
+	unsigned const low = static_cast<unsigned>(mask);
+	return low ? trailing_zeros(low) : 32 + trailing_zeros(static_cast<unsigned>(mask >> 32));
+#endif
+}
+
+} // namespace safe_detail
+} // namespace safe_data
+
+#endif
@@ -0,0 +1,164 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/sort.h
+
+Created: 2026.10.18
+
+Description:
+	Sorting for sequences of safe<> integers whose validation has static
+	bounds, such as range_validation<int, int_<0>, int_<1000> >. The bounds
+	are checked at compile time and pick the algorithm:
+
+		range of at most counting_sort_limit values    counting sort
+		any other bounded range                        LSD radix sort of value - lower
+		no static bounds, or not an integer            std::sort
+
+	A small input, or one much smaller than the range it would count, also
+	uses std::sort, and so does an input holding a value outside the bounds,
+	such as the invalid default of a safe<> built with NDEBUG. The sorted
+	values come from the input, so they are written back unchecked.
+
+		std::vector<score> scores = ...;
+		safe_sort(scores.begin(), scores.end());
+*/
+
+#ifndef SAFE_DATA_SORT_MPN_18OCT2026_HPP
+#define SAFE_DATA_SORT_MPN_18OCT2026_HPP
+
+#include "safe_data/safe.h"
+#include "safe_data/validations.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace safe_data {
+
+// widest range sorted by counting
+#if __cplusplus >= 201703L
+inline constexpr std::size_t counting_sort_limit = std::size_t(1) << 16;
+#else
+static std::size_t const counting_sort_limit = std::size_t(1) << 16;
+#endif
+
+namespace safe_detail {
+
+enum sort_method {
+	sort_compare,
+	sort_counting,
+	sort_radix
+};
+
+template <class Safe>
+struct sort_traits : dense_key<Safe> {
+	static sort_method const method = !dense_key<Safe>::bounded ? sort_compare
+		: dense_key<Safe>::width <= counting_sort_limit ? sort_counting : sort_radix;
+};
+
+template <class It>
+void compare_sort(It first, It last)
+{
+	typedef typename std::iterator_traits<It>::value_type safe_type;
+	std::sort(first, last, [](safe_type const& a, safe_type const& b) { return a.data() < b.data(); });
+}
+
+template <class It>
+void sort(It first, It last, std::integral_constant<sort_method, sort_compare>)
+{ compare_sort(first, last); }
+
+template <class It>
+void sort(It first, It last, std::integral_constant<sort_method, sort_counting>)
+{
+	typedef typename std::iterator_traits<It>::value_type safe_type;
+	typedef sort_traits<safe_type>                        traits;
+
+	std::size_t const width = static_cast<std::size_t>(traits::width);
+	std::size_t const n = static_cast<std::size_t>(last - first);
+	if ( n < 64 || n * 4 < width ) {
+		compare_sort(first, last);
+		return;
+	}
+
+	std::vector<std::size_t> counts(width);
+	for (It it = first; it != last; ++it) {
+		unsigned long long const k = traits::key(it->data());
+		if ( k >= width ) {
+			compare_sort(first, last);
+			return;
+		}
+		++counts[k];
+	}
+
+	It out = first;
+	for (std::size_t k = 0; k < width; ++k)
+		for (std::size_t c = counts[k]; c; --c, ++out)
+			*out = safe_type(unchecked, traits::value(k));
+}
+
+template <class It>
+void sort(It first, It last, std::integral_constant<sort_method, sort_radix>)
+{
+	typedef typename std::iterator_traits<It>::value_type safe_type;
+	typedef sort_traits<safe_type>                        traits;
+
+	std::size_t const n = static_cast<std::size_t>(last - first);
+	if ( n < 256 ) {
+		compare_sort(first, last);
+		return;
+	}
+
+	unsigned long long const max_key = static_cast<unsigned long long>(traits::width - 1);
+	std::vector<unsigned long long> keys(n), work(n);
+	for (std::size_t i = 0; i < n; ++i) {
+		keys[i] = traits::key(first[i].data());
+		if ( keys[i] > max_key ) {
+			compare_sort(first, last);
+			return;
+		}
+	}
+
+	// one pass per byte of the widest key, skipping bytes every key shares
+	for (unsigned shift = 0; shift < 64 && (max_key >> shift); shift += 8) {
+		std::size_t counts[256] = { };
+		for (std::size_t i = 0; i < n; ++i)
+			++counts[(keys[i] >> shift) & 0xFF];
+		if ( counts[(keys[0] >> shift) & 0xFF] == n )
+			continue;
+
+		std::size_t offset = 0;
+		for (unsigned d = 0; d < 256; ++d) {
+			std::size_t const c = counts[d];
+			counts[d] = offset;
+			offset += c;
+		}
+		for (std::size_t i = 0; i < n; ++i)
+			work[counts[(keys[i] >> shift) & 0xFF]++] = keys[i];
+		keys.swap(work);
+	}
+
+	for (std::size_t i = 0; i < n; ++i)
+		first[i] = safe_type(unchecked, traits::value(keys[i]));
+}
+
+} // namespace safe_detail
+
+
+template <class RandomIt>
+inline void safe_sort(RandomIt first, RandomIt last)
+{
+	typedef typename std::iterator_traits<RandomIt>::value_type safe_type;
+	safe_detail::sort(first, last,
+		std::integral_constant<safe_detail::sort_method, safe_detail::sort_traits<safe_type>::method>());
+}
+
+template <class Container>
+inline void safe_sort(Container& c)
+{ safe_sort(c.begin(), c.end()); }
+
+} // namespace safe_data
+
+#endif
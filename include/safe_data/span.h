@@ -0,0 +1,94 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/span.h
+
+Created: 2026.10.18
+
+Description:
+	Non-owning validated view over an external array, such as a DMA buffer,
+	shared memory or a network frame. The elements are validated when the
+	view is created and again on revalidate(). Writes through set() are
+	validated one element at a time.
+
+	Writes that bypass the view (through mutable_data() or by the owner of the
+	buffer) cannot be checked, so the view records that it is dirty until the
+	next revalidate(). Reads from a dirty view may see invalid data.
+*/
+
+#ifndef SAFE_DATA_SPAN_MPN_18OCT2026_HPP
+#define SAFE_DATA_SPAN_MPN_18OCT2026_HPP
+
+#include "safe_data/safe.h"
+#include "safe_data/parallel.h"
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace safe_data {
+
+// safe_span - throws element_exception when the viewed data is invalid
+template <class T, class validation = no_validation<T> >
+class safe_span {
+public:
+	typedef T                          value_type;
+	typedef validation                 validation_type;
+	typedef safe<T const&, validation> const_reference;
+	typedef T const*                   const_iterator;
+	typedef std::size_t                size_type;
+
+	safe_span(T* data, size_type size, parallel_options const& options = parallel_options()) :
+		data_(data), size_(size), dirty_(true)
+	{ revalidate(options); }
+
+	template <class Container>
+	explicit safe_span(Container& c, parallel_options const& options = parallel_options()) :
+		data_(c.data()), size_(c.size()), dirty_(true)
+	{ revalidate(options); }
+
+// access
+	size_type size() const { return size_; }
+	bool     empty() const { return size_ == 0; }
+	bool     dirty() const { return dirty_; }
+
+	const_reference operator[] (size_type i) const { return const_reference(unchecked, data_[i]); }
+	const_reference at(size_type i) const
+	{
+		if ( i >= size_ )
+			throw std::out_of_range("safe_span::at");
+		return (*this)[i];
+	}
+
+	T const* data() const { return data_; }
+	const_iterator begin() const { return data_; }
+	const_iterator end()   const { return data_ + size_; }
+
+// modify
+	void set(size_type i, T const& value)
+	{
+		if ( i >= size_ )
+			throw std::out_of_range("safe_span::set");
+		validation_type::validate(value);
+		data_[i] = value;
+	}
+
+	// unchecked access; the view is dirty until revalidated
+	T* mutable_data() { dirty_ = true; return data_; }
+	void mark_dirty() { dirty_ = true; }
+
+	void revalidate(parallel_options const& options = parallel_options())
+	{
+		parallel_validate<validation_type>(data_, size_, options);
+		dirty_ = false;
+	}
+
+private:
+	T*        data_;
+	size_type size_;
+	bool      dirty_;
+};
+
+} // namespace safe_data
+
+#endif
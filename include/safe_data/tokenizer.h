@@ -0,0 +1,119 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	safe_data/tokenizer.h
+
+Created: 2026.10.18
+
+Description:
+	Splits a buffer on a delimiter and yields each field as a validated
+	safe<std::string_view>. The fields point into the input, so nothing is
+	allocated or copied. Each field is validated once, when the iterator
+	reaches it. A field that fails is recorded rather than thrown, so begin()
+	and ++ never throw; dereferencing the bad field throws its validation
+	exception. valid() tests the current field without throwing, view()
+	returns its raw text, and ++ moves past it.
+
+		typedef safe<std::string_view, str_length_validation<std::string_view, size_t<8> > > field;
+		for (field f : tokenize<field>(line, ','))
+			...
+
+	The input must outlive the tokens. Requires C++17.
+*/
+
+#ifndef SAFE_DATA_TOKENIZER_MPN_18OCT2026_HPP
+#define SAFE_DATA_TOKENIZER_MPN_18OCT2026_HPP
+
+#if __cplusplus < 201703L
+#error "safe_data/tokenizer.h requires C++17"
+#endif
+
+#include "safe_data/safe.h"
+
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <string_view>
+
+namespace safe_data {
+
+template <class Safe>
+class token_range {
+public:
+	typedef Safe value_type;
+
+	class iterator {
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef Safe                      value_type;
+		typedef std::ptrdiff_t            difference_type;
+		typedef Safe const*               pointer;
+		typedef Safe                      reference;
+
+		iterator() : input_(), delim_(), pos_(npos), token_(), error_() { }
+		iterator(std::string_view input, char delim) :
+			input_(input), delim_(delim), pos_(input.empty() ? npos : 0), token_(), error_()
+		{ next(); }
+
+		reference operator* () const
+		{
+			if ( error_ )
+				std::rethrow_exception(error_);
+			return Safe(unchecked, token_);
+		}
+		std::string_view view() const { return token_; }
+		bool valid() const { return !error_; }
+
+		iterator& operator++ () { next(); return *this; }
+		iterator  operator++ (int) { iterator it(*this); next(); return it; }
+
+		bool operator== (iterator const& rhs) const { return pos_ == rhs.pos_; }
+		bool operator!= (iterator const& rhs) const { return pos_ != rhs.pos_; }
+
+	private:
+		static std::size_t const npos = std::string_view::npos;
+
+		void next()
+		{
+			if ( pos_ == npos )
+				return;
+			if ( pos_ > input_.size() ) {
+				pos_ = npos;
+				return;
+			}
+			std::size_t const end = input_.find(delim_, pos_);
+			token_ = end == npos ? input_.substr(pos_) : input_.substr(pos_, end - pos_);
+			pos_ = end == npos ? input_.size() + 1 : end + 1;
+			error_ = std::exception_ptr();
+			try {
+				Safe::validation_type::validate(token_);
+			} catch (...) {
+				error_ = std::current_exception();
+			}
+		}
+
+		std::string_view   input_;
+		char               delim_;
+		std::size_t        pos_;
+		std::string_view   token_;
+		std::exception_ptr error_;
+	};
+
+	token_range(std::string_view input, char delim) : input_(input), delim_(delim) { }
+
+	iterator begin() const { return iterator(input_, delim_); }
+	iterator end()   const { return iterator(); }
+
+private:
+	std::string_view input_;
+	char             delim_;
+};
+
+template <class Safe>
+inline token_range<Safe> tokenize(std::string_view input, char delim)
+{ return token_range<Safe>(input, delim); }
+
+} // namespace safe_data
+
+#endif
@@ -17,6 +17,13 @@ Description:
 
 #include "safe_data/exceptions.h"
 
+#include <cstddef>
+#include <type_traits>
+
+#if __cplusplus >= 201703L
+#include "safe_data/values.h"
+#endif
+
 namespace safe_data {
 
 
@@ -26,9 +33,11 @@ struct min_validation {
 	typedef min_value value;
 	typedef exception exception_type;
 	typedef typename safe_detail::types<T>::argument_type argument_type;
+	static inline bool is_valid(argument_type data)
+	{ return !( data < value() ); }
 	static inline void validate(argument_type data)
 	{
-		if ( data < value() )
+		if ( !is_valid(data) )
 			throw exception_type(data);
 	}
 };
@@ -38,9 +47,11 @@ struct min_validation_lte {
 	typedef min_value value;
 	typedef exception exception_type;
 	typedef typename safe_detail::types<T>::argument_type argument_type;
+	static inline bool is_valid(argument_type data)
+	{ return !( data <= value() ); }
 	static inline void validate(argument_type data)
 	{
-		if ( data <= value() )
+		if ( !is_valid(data) )
 			throw exception_type(data);
 	}
 };
@@ -51,9 +62,11 @@ struct max_validation {
 	typedef max_value value;
 	typedef exception  exception_type;
 	typedef typename safe_detail::types<T>::argument_type argument_type;
+	static inline bool is_valid(argument_type data)
+	{ return !( data > value() ); }
 	static inline void validate(argument_type data)
 	{
-		if ( data > value() )
+		if ( !is_valid(data) )
 			throw exception_type(data);
 	}
 };
@@ -63,9 +76,11 @@ struct max_validation_gte {
 	typedef max_value value;
 	typedef exception exception_type;
 	typedef typename safe_detail::types<T>::argument_type argument_type;
+	static inline bool is_valid(argument_type data)
+	{ return !( data >= value() ); }
 	static inline void validate(argument_type data)
 	{
-		if ( data >= value() )
+		if ( !is_valid(data) )
 			throw exception_type(data);
 	}
 };
@@ -77,9 +92,11 @@ struct range_validation {
     typedef max_value upper;
 	typedef exception exception_type;
 	typedef typename safe_detail::types<T>::argument_type argument_type;
+	static inline bool is_valid(argument_type data)
+	{ return !( data < lower() || data > upper() ); }
 	static inline void validate(argument_type data)
 	{
-		if ( data < lower() || data > upper() )
+		if ( !is_valid(data) )
 			throw exception_type(data);
 	}
 };
@@ -90,9 +107,11 @@ struct range_validation_min_lte_max_gte {
     typedef max_value upper;
 	typedef exception exception_type;
 	typedef typename safe_detail::types<T>::argument_type argument_type;
+	static inline bool is_valid(argument_type data)
+	{ return !( data <= lower() || data >= upper() ); }
 	static inline void validate(argument_type data)
 	{
-		if ( data <= lower() || data >= upper() )
+		if ( !is_valid(data) )
 			throw exception_type(data);
 	}
 };
@@ -103,9 +122,11 @@ struct range_validation_min_lte {
     typedef max_value upper;
 	typedef exception exception_type;
 	typedef typename safe_detail::types<T>::argument_type argument_type;
+	static inline bool is_valid(argument_type data)
+	{ return !( data <= lower() || data > upper() ); }
 	static inline void validate(argument_type data)
 	{
-		if ( data <= lower() || data > upper() )
+		if ( !is_valid(data) )
 			throw exception_type(data);
 	}
 };
@@ -116,9 +137,11 @@ struct range_validation_max_gte {
     typedef max_value upper;
 	typedef exception exception_type;
 	typedef typename safe_detail::types<T>::argument_type argument_type;
+	static inline bool is_valid(argument_type data)
+	{ return !( data < lower() || data >= upper() ); }
 	static inline void validate(argument_type data)
 	{
-		if ( data < lower() || data >= upper() )
+		if ( !is_valid(data) )
 			throw exception_type(data);
 	}
 };
@@ -129,10 +152,17 @@ struct size_validation {
 	typedef size value;
 	typedef exception  exception_type;
 	typedef typename safe_detail::types<T>::argument_type argument_type;
-	static inline void validate(argument_type container) {
-		if ( container.size() > value() )
+	static inline bool is_valid(argument_type container)
+	{ return !( container.size() > value() ); }
+	static inline void validate(argument_type container)
+	{
+		if ( !is_valid(container) )
 			throw exception_type(container);
 	}
+	static inline void validate_size(std::size_t n) {
+		if ( n > value() )
+			throw exception_type(exception_type::size_msg(n));
+	}
 };
 
 // length validations for strings
@@ -141,12 +171,90 @@ struct str_length_validation {
 	typedef length value;
 	typedef exception  exception_type;
 	typedef typename safe_detail::types<T>::argument_type argument_type;
-	static inline void validate(argument_type str) {
-		if ( str.length() > value() )
+	static inline bool is_valid(argument_type str)
+	{ return !( str.length() > value() ); }
+	static inline void validate(argument_type str)
+	{
+		if ( !is_valid(str) )
 			throw exception_type(str, str.length());
 	}
+	static inline void validate_size(std::size_t len) {
+		if ( len > value() )
+			throw exception_type(exception_type::length_msg(len));
+	}
+};
+
+namespace safe_detail {
+
+// the range a validation accepts, when it is known at compile time
+template <class V>
+struct static_bounds {
+	static bool const known = false;
+	static constexpr double lower = 0;
+	static constexpr double upper = 0;
+};
+
+// true for an integral constant bound; a SAFE_DATA_INITIAL_VALUE bound has only a conversion
+template <class B>
+struct has_value {
+	template <class U> static char test(decltype(&U::value));
+	template <class U> static long test(...);
+	static bool const value = sizeof(test<B>(0)) == sizeof(char);
+};
+
+template <class L, class U, bool = has_value<L>::value && has_value<U>::value>
+struct constant_bounds {
+	static bool const known = false;
+	static constexpr double lower = 0;
+	static constexpr double upper = 0;
+};
+
+template <class L, class U>
+struct constant_bounds<L, U, true> {
+	static bool const known = true;
+	static constexpr double lower = L::value;
+	static constexpr double upper = U::value;
 };
 
+template <class T, class L, class U, class E>
+struct static_bounds<range_validation<T, L, U, E> > : constant_bounds<L, U> { };
+
+// a safe<> integer with static bounds, as an offset from its lower bound
+template <class Safe>
+struct dense_key {
+	typedef typename Safe::raw_type        raw_type;
+	typedef static_bounds<typename Safe::validation_type> bounds;
+
+	// integers below 2^53 are exact in the double bounds
+	static bool const bounded = bounds::known
+		&& std::is_integral<raw_type>::value
+		&& !std::is_reference<typename Safe::value_type>::value
+		&& bounds::lower > -9007199254740992.0 && bounds::upper < 9007199254740992.0;
+
+	static constexpr double width = bounded ? bounds::upper - bounds::lower + 1 : 0;
+	static constexpr long long lower = bounded ? static_cast<long long>(bounds::lower) : 0;
+
+	static unsigned long long key(raw_type v)
+	{ return static_cast<unsigned long long>(static_cast<long long>(v) - lower); }
+	static raw_type value(unsigned long long k)
+	{ return static_cast<raw_type>(static_cast<long long>(k) + lower); }
+};
+
+} // namespace safe_detail
+
+#if __cplusplus >= 201703L
+// validations with their bounds as template arguments, e.g. range<0, 100> or
+// range<0.0, 1.0>; the value type is the common type of the bounds
+template <auto lower, auto upper>
+using range = range_validation<typename std::common_type<decltype(lower), decltype(upper)>::type,
+	constant<lower>, constant<upper> >;
+
+template <auto lower>
+using at_least = min_validation<decltype(lower), constant<lower> >;
+
+template <auto upper>
+using at_most = max_validation<decltype(upper), constant<upper> >;
+#endif
 
 } // namespace safe_data
 
@@ -18,6 +18,15 @@ Description:
 #include <boost/mpl/size_t.hpp>
 #include <boost/mpl/string.hpp>
 
+#if __cplusplus >= 202002L
+#include <cstddef>
+#include <string_view>
+#endif
+
+#if __cplusplus >= 201703L
+#include <type_traits>
+#endif
+
 namespace safe_data {
 
 // only use this when there is no alternative in boost MPL, like for doubles
@@ -36,6 +45,43 @@ struct c_str {
     operator const char*() const { return type::value; }
 };
 
+#if __cplusplus >= 201703L
+// compile-time value usable wherever an MPL integral constant is, e.g.
+// range_validation<int, constant<0>, constant<100> >; floating point values need C++20
+template <auto V>
+struct constant {
+    typedef decltype(V) value_type;
+    static constexpr value_type value = V;
+    constexpr operator value_type() const { return V; }
+};
+#endif
+
+#if __cplusplus >= 202002L
+// string literal usable as a template argument, e.g. pattern_validation<T, "[0-9]+">
+template <std::size_t N>
+struct fixed_string {
+    char value[N];
+
+    constexpr fixed_string(char const (&str)[N])
+    {
+        for (std::size_t i = 0; i < N; ++i)
+            value[i] = str[i];
+    }
+
+    constexpr std::size_t size() const { return N - 1; }
+    constexpr char operator[] (std::size_t i) const { return value[i]; }
+    constexpr std::string_view view() const { return std::string_view(value, N - 1); }
+    constexpr operator const char*() const { return value; }
+};
+
+// string literal initial value, e.g. safe<std::string, V, initial<"foo"> >
+template <fixed_string S>
+struct initial {
+    static constexpr char const* value = S.value;
+    constexpr operator const char*() const { return S.value; }
+};
+#endif
+
 } // namespace safe_data
 
 #endif
@@ -0,0 +1,235 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+
+File:
+	modules/safe_data.cppm
+
+Created: 2026.10.18
+
+Description:
+	The safe_data named module. It exports the same names as
+	safe_data_all.h, so a translation unit can write
+
+		import safe_data;
+
+	instead of including the headers. Boost MPL and the standard headers are
+	then parsed once, when the module is built, instead of in every
+	translation unit.
+
+	Macros are not exported by a module. SAFE_DATA_INITIAL_VALUE, and the
+	SAFE_DATA_DEFAULT_VALIDATION_LEVEL and SAFE_DATA_DEFAULT_SAMPLE_RATE
+	settings, need the headers, either included or imported as a header
+	unit (import <safe_data/safe_data_all.h>;). Those settings must be defined
+	when the module is built. With C++20 bounds, initial<"..."> replaces
+	SAFE_DATA_INITIAL_VALUE.
+*/
+
+module;
+
+#include "safe_data/safe_data_all.h"
+
+export module safe_data;
+
+export namespace safe_data {
+
+// safe.h
+using safe_data::safe;
+using safe_data::no_initial;
+using safe_data::no_validation;
+using safe_data::unchecked_t;
+using safe_data::unchecked;
+using safe_data::is_safe;
+using safe_data::get;
+
+// values.h
+using safe_data::c_str;
+#if __cplusplus >= 201703L
+using safe_data::constant;
+#endif
+#if __cplusplus >= 202002L
+using safe_data::fixed_string;
+using safe_data::initial;
+#endif
+
+// validations.h
+using safe_data::min_validation;
+using safe_data::min_validation_lte;
+using safe_data::max_validation;
+using safe_data::max_validation_gte;
+using safe_data::range_validation;
+using safe_data::range_validation_min_lte_max_gte;
+using safe_data::range_validation_min_lte;
+using safe_data::range_validation_max_gte;
+using safe_data::size_validation;
+using safe_data::str_length_validation;
+#if __cplusplus >= 201703L
+using safe_data::range;
+using safe_data::at_least;
+using safe_data::at_most;
+#endif
+
+// exceptions.h
+using safe_data::min_exception;
+using safe_data::max_exception;
+using safe_data::range_exception;
+using safe_data::size_exception;
+using safe_data::str_length_exception;
+using safe_data::element_exception;
+
+// compare.h, operators.h and io.h
+using safe_data::operator==;
+using safe_data::operator!=;
+using safe_data::operator<;
+using safe_data::operator>;
+using safe_data::operator<=;
+using safe_data::operator>=;
+using safe_data::operator+;
+using safe_data::operator-;
+using safe_data::operator*;
+using safe_data::operator/;
+using safe_data::operator%;
+using safe_data::operator&&;
+using safe_data::operator||;
+using safe_data::operator&;
+using safe_data::operator|;
+using safe_data::operator^;
+using safe_data::operator<<;
+using safe_data::operator>>;
+using safe_data::operator+=;
+using safe_data::operator-=;
+using safe_data::operator*=;
+using safe_data::operator/=;
+using safe_data::operator%=;
+using safe_data::operator&=;
+using safe_data::operator|=;
+using safe_data::operator^=;
+using safe_data::operator<<=;
+using safe_data::operator>>=;
+
+// async.h
+using safe_data::validation_pool;
+using safe_data::pending_assignment;
+using safe_data::assign_async;
+
+// charset.h
+using safe_data::char_ranges;
+using safe_data::ascii;
+using safe_data::printable;
+using safe_data::alnum;
+using safe_data::digit;
+using safe_data::xdigit;
+using safe_data::utf8;
+using safe_data::charset_exception;
+using safe_data::charset_validation;
+using safe_data::ascii_validation;
+using safe_data::utf8_validation;
+using safe_data::str_length_charset_validation;
+
+// collect.h
+using safe_data::violation_kind;
+using safe_data::min_violation;
+using safe_data::max_violation;
+using safe_data::range_violation;
+using safe_data::size_violation;
+using safe_data::length_violation;
+using safe_data::other_violation;
+using safe_data::violation_kinds;
+using safe_data::violation;
+using safe_data::violation_sink;
+using safe_data::check;
+using safe_data::try_assign;
+
+// deferred.h
+using safe_data::deferred_validation;
+using safe_data::edit;
+
+// expression.h
+using safe_data::expression;
+using safe_data::lazy;
+
+// floating.h
+using safe_data::finite_exception;
+using safe_data::finite_validation;
+using safe_data::finite_range_validation;
+
+// hash.h
+using safe_data::safe_hash;
+using safe_data::safe_equal;
+using safe_data::safe_less;
+
+// index.h
+using safe_data::safe_index_map;
+using safe_data::safe_index_set;
+using safe_data::safe_index_bitset;
+
+// interned.h
+using safe_data::interned_safe_string;
+
+// levels.h
+using safe_data::validation_level;
+using safe_data::validate_always;
+using safe_data::validate_debug_only;
+using safe_data::validate_sampled;
+using safe_data::validate_off;
+using safe_data::violation_handler;
+using safe_data::set_violation_handler;
+using safe_data::get_violation_handler;
+using safe_data::leveled_validation;
+
+// memoized.h
+using safe_data::memo_stats;
+using safe_data::memoized_validation;
+
+// parallel.h
+using safe_data::failure_mode;
+using safe_data::stop_on_first_failure;
+using safe_data::collect_all_failures;
+using safe_data::parallel_options;
+using safe_data::parallel_find_invalid;
+using safe_data::parallel_validate;
+using safe_data::elements_validation;
+
+// record.h
+using safe_data::field_mask;
+using safe_data::depends_on;
+using safe_data::safe_record;
+
+// shared.h
+using safe_data::shared_safe;
+
+// sort.h
+using safe_data::counting_sort_limit;
+using safe_data::safe_sort;
+
+// span.h
+using safe_data::safe_span;
+
+#if __cplusplus >= 201402L
+// one_of.h
+using safe_data::one_of_exception;
+using safe_data::one_of_validation;
+#endif
+
+#if __cplusplus >= 201703L
+// tokenizer.h
+using safe_data::token_range;
+using safe_data::tokenize;
+#endif
+
+#if __cplusplus >= 202002L
+// one_of.h and pattern.h
+using safe_data::one_of_str_exception;
+using safe_data::one_of_str_validation;
+using safe_data::pattern_exception;
+using safe_data::pattern_validation;
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+// mapped_array.h
+using safe_data::mapping_mode;
+using safe_data::map_read_only;
+using safe_data::map_read_write;
+using safe_data::mapped_safe_array;
+#endif
+
+} // namespace safe_data
@@ -0,0 +1,69 @@
+#!/bin/bash
+#
+# Copyright Mike Naquin, 2026. All rights reserved.
+# File:
+#	build_timing.sh
+#
+# Created: 2026.10.18
+#
+# Description:
+#	times how long a translation unit takes to compile when it includes
+#	safe_data.h, includes safe_data_all.h, or imports the safe_data module,
+#	and how many lines each include preprocesses to. Each figure is the best
+#	of three runs. Run it from this directory on an otherwise idle machine:
+#
+#		./build_timing.sh                    # g++, -std=c++20
+#		CXX=clang++ STD=c++17 ./build_timing.sh
+#
+#	The module is built and imported only with g++ and -std=c++20 or later,
+#	using -fmodules-ts.
+
+CXX=${CXX:-g++}
+STD=${STD:-c++20}
+INCLUDE=$(cd "$(dirname "$0")/../include" && pwd)
+MODULE=$(cd "$(dirname "$0")/../modules" && pwd)/safe_data.cppm
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+cd "$WORK" || exit 1
+
+# milliseconds for the best of three runs of a command, or "failed"
+best_of_three() {
+	local best=
+	for run in 1 2 3; do
+		local start=$(date +%s%N)
+		"$@" > /dev/null 2>&1 || { echo failed; return; }
+		local ms=$(( ($(date +%s%N) - start) / 1000000 ))
+		if [ -z "$best" ] || [ "$ms" -lt "$best" ]; then
+			best=$ms
+		fi
+	done
+	echo "$best ms"
+}
+
+for header in safe_data.h safe_data_all.h; do
+	cat > "${header%.h}.cpp" <<EOF
+#include "safe_data/$header"
+safe_data::safe<int> value;
+EOF
+done
+echo 'int main() { return 0; }' > empty.cpp
+
+printf '%-28s %10s %12s\n' "translation unit" "lines" "-c"
+printf '%-28s %10s %12s\n' "empty" "-" "$(best_of_three $CXX -std=$STD -c empty.cpp)"
+for header in safe_data.h safe_data_all.h; do
+	tu=${header%.h}.cpp
+	lines=$($CXX -std=$STD -I"$INCLUDE" -E $tu | wc -l)
+	printf '%-28s %10s %12s\n' "#include <$header>" "$lines" "$(best_of_three $CXX -std=$STD -I"$INCLUDE" -c $tu)"
+done
+
+case "$CXX:$STD" in
+*g++*:c++2*|*g++*:gnu++2*)
+	echo 'import safe_data;' > import.cpp
+	echo 'int main() { return 0; }' >> import.cpp
+	build=$(best_of_three $CXX -std=$STD -fmodules-ts -I"$INCLUDE" -x c++ -c "$MODULE" -o safe_data.o)
+	printf '%-28s %10s %12s\n' "module interface (once)" "-" "$build"
+	if [ "$build" != failed ]; then
+		printf '%-28s %10s %12s\n' "import safe_data;" "-" "$(best_of_three $CXX -std=$STD -fmodules-ts -c import.cpp)"
+	fi
+	;;
+esac
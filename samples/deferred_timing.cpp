@@ -0,0 +1,81 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+File:
+	deferred_timing.cpp
+
+Created: 2026.10.18
+
+Description:
+	times 1K increments of a safe<int> done one validated ++ at a time
+	against the same increments made through an edit() handle and validated
+	once on commit(). The unvalidated steps have no observable effect, so
+	the optimizer is free to fold them; that is part of what is measured.
+	Build it on its own, with optimization:
+
+		g++ -std=c++11 -O2 -I../include deferred_timing.cpp -o deferred_timing
+		./deferred_timing [rounds]
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "safe_data/deferred.h"
+#include "safe_data/safe.h"
+#include "safe_data/validations.h"
+
+using safe_data::edit;
+using safe_data::deferred_validation;
+using boost::mpl::int_;
+
+typedef safe_data::safe<int, safe_data::range_validation<int, int_<0>, int_<1000000> > > counter;
+
+static int const steps = 1000;
+
+template <class F>
+double best_of(int runs, F f)
+{
+	double best = 0;
+	for (int run = 0; run < runs; ++run) {
+		std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+		f();
+		double const ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		if ( run == 0 || ms < best )
+			best = ms;
+	}
+	return best;
+}
+
+int main(int argc, char* argv[])
+{
+	long const rounds = argc > 1 ? std::strtol(argv[1], 0, 10) : 100000;
+	volatile int sink = 0;
+
+	double const per_step = best_of(5, [&] {
+		for (long r = 0; r < rounds; ++r) {
+			int const start = sink;
+			counter c(start);
+			for (int n = 0; n < steps; ++n)
+				++c;
+			sink = c.data() - steps;
+		}
+	});
+
+	double const deferred = best_of(5, [&] {
+		for (long r = 0; r < rounds; ++r) {
+			int const start = sink;
+			counter c(start);
+			deferred_validation<counter> e = edit(c);
+			for (int n = 0; n < steps; ++n)
+				++*e;
+			e.commit();
+			sink = c.data() - steps;
+		}
+	});
+
+	std::cout << rounds << " x " << steps << " increments" << std::endl;
+	std::cout << "++s:     " << per_step << " ms, " << per_step * 1e6 / rounds << " ns/round" << std::endl;
+	std::cout << "edit(s): " << deferred << " ms, " << deferred * 1e6 / rounds << " ns/round, "
+		<< per_step / deferred << "x" << std::endl;
+	return 0;
+}
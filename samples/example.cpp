@@ -14,6 +14,7 @@ Description:
 #include <string>
 
 #include "safe_data/safe_data.h"
+#include "safe_data/floating.h"
 
 using safe_data::safe;
 using safe_data::no_initial;
@@ -22,16 +23,17 @@ using safe_data::no_validation;
 using safe_data::c_str;
 using boost::mpl::int_;
       
+using safe_data::finite_range_validation;
 using safe_data::max_validation;
-using safe_data::range_validation;
 using safe_data::str_length_validation;
 
 // A floating point percent type with valid values between 0.0 and 1.0. Defaults to 0.5.
+// NaN and infinity are rejected.
 SAFE_DATA_INITIAL_VALUE(double_init, double, 0.5)
 
 typedef safe<
     double,
-    range_validation<double, int_<0>, int_<1> >,
+    finite_range_validation<double, int_<0>, int_<1> >,
     double_init
 > percent;
 
@@ -0,0 +1,86 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+File:
+	index_timing.cpp
+
+Created: 2026.10.18
+
+Description:
+	times random lookups of safe<> port numbers in std::unordered_map and
+	std::unordered_set against safe_index_map, safe_index_set and
+	safe_index_bitset. 20K of the 65535 ports are populated. Build it on
+	its own, with optimization:
+
+		g++ -std=c++11 -O2 -I../include index_timing.cpp -o index_timing
+		./index_timing [lookups]
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "safe_data/hash.h"
+#include "safe_data/index.h"
+
+using safe_data::safe_index_map;
+using safe_data::safe_index_set;
+using safe_data::safe_index_bitset;
+using boost::mpl::int_;
+
+typedef safe_data::safe<int, safe_data::range_validation<int, int_<1>, int_<65535> >, int_<1> > port;
+
+template <class F>
+void time_lookups(char const* name, std::vector<port> const& queries, F f, long long& sink)
+{
+	std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < queries.size(); ++i)
+		sink += f(queries[i]);
+	double const ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	std::cout << name << ": " << ns / queries.size() << " ns/lookup" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t const lookups = argc > 1 ? std::strtoul(argv[1], 0, 10) : 20000000;
+
+	std::mt19937 gen(3);
+	std::uniform_int_distribution<int> dist(1, 65535);
+
+	std::unordered_map<port, int> umap;
+	std::unordered_set<port>      uset;
+	safe_index_map<port, int>     imap;
+	safe_index_set<port>          iset;
+	safe_index_bitset<port>       ibits;
+	for (int i = 0; i < 20000; ++i) {
+		port const p(dist(gen));
+		umap[p] = i;
+		uset.insert(p);
+		imap[p] = i;
+		iset.insert(p);
+		ibits.insert(p);
+	}
+
+	std::vector<port> queries;
+	queries.reserve(lookups);
+	for (std::size_t i = 0; i < lookups; ++i)
+		queries.push_back(port(dist(gen)));
+
+	long long sink = 0;
+	time_lookups("unordered_map    ", queries, [&](port const& p) -> int {
+		std::unordered_map<port, int>::const_iterator it = umap.find(p);
+		return it == umap.end() ? 0 : it->second;
+	}, sink);
+	time_lookups("safe_index_map   ", queries, [&](port const& p) -> int {
+		int const* v = imap.find(p);
+		return v ? *v : 0;
+	}, sink);
+	time_lookups("unordered_set    ", queries, [&](port const& p) -> int { return static_cast<int>(uset.count(p)); }, sink);
+	time_lookups("safe_index_set   ", queries, [&](port const& p) -> int { return iset.contains(p); }, sink);
+	time_lookups("safe_index_bitset", queries, [&](port const& p) -> int { return ibits.contains(p); }, sink);
+	std::cout << "(" << sink << ")" << std::endl;
+	return 0;
+}
@@ -0,0 +1,90 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+File:
+	memoized_timing.cpp
+
+Created: 2026.10.18
+
+Description:
+	times an expensive validation, parsing an ISO date string, with and
+	without memoized_validation. Keys are drawn from 10K dates with a
+	Zipfian distribution, so a small hot set covers most lookups, the way
+	real ingest traffic does. Build it on its own, with optimization:
+
+		g++ -std=c++11 -O2 -I../include memoized_timing.cpp -o memoized_timing
+		./memoized_timing [lookups]
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/date_time/gregorian/gregorian.hpp>
+
+#include "safe_data/memoized.h"
+#include "safe_data/safe.h"
+
+using boost::gregorian::date;
+using boost::gregorian::days;
+
+// the string must parse as an ISO date
+struct iso_date_validation {
+	typedef std::invalid_argument exception_type;
+	static void validate(std::string const& s)
+	{
+		if ( boost::gregorian::from_simple_string(s).is_special() )
+			throw exception_type("not an ISO date");
+	}
+};
+
+typedef safe_data::memoized_validation<iso_date_validation, 1024> memo;
+
+typedef safe_data::safe<std::string, iso_date_validation> plain_date;
+typedef safe_data::safe<std::string, memo> cached_date;
+
+template <class Safe>
+double time_lookups(std::vector<std::string> const& keys, std::vector<int> const& sequence, std::size_t& sink)
+{
+	std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < sequence.size(); ++i) {
+		Safe s(keys[sequence[i]]);
+		sink += s.data().size();
+	}
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / sequence.size();
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t const lookups = argc > 1 ? std::strtoul(argv[1], 0, 10) : 2000000;
+
+	std::vector<std::string> keys;
+	date const first(2000, 1, 1);
+	for (int i = 0; i < 10000; ++i)
+		keys.push_back(boost::gregorian::to_iso_extended_string(first + days(i)));
+
+	// Zipfian, s = 1.1: the 100 hottest keys draw about 65% of the lookups
+	std::vector<double> weights(keys.size());
+	for (std::size_t i = 0; i < weights.size(); ++i)
+		weights[i] = 1.0 / std::pow(i + 1.0, 1.1);
+	std::discrete_distribution<int> zipf(weights.begin(), weights.end());
+	std::mt19937 gen(7);
+	std::vector<int> sequence(lookups);
+	for (std::size_t i = 0; i < sequence.size(); ++i)
+		sequence[i] = zipf(gen);
+
+	std::size_t sink = 0;
+	double const plain = time_lookups<plain_date>(keys, sequence, sink);
+	memo::reset_stats();
+	double const cached = time_lookups<cached_date>(keys, sequence, sink);
+
+	std::cout << lookups << " lookups over " << keys.size() << " keys (" << sink << ')' << std::endl;
+	std::cout << "validate:            " << plain << " ns/lookup" << std::endl;
+	std::cout << "memoized_validation: " << cached << " ns/lookup, hit rate " << memo::stats().hit_rate()
+		<< ", " << plain / cached << "x" << std::endl;
+	return 0;
+}
@@ -0,0 +1,58 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+File:
+	parallel_timing.cpp
+
+Created: 2026.10.18
+
+Description:
+	times parallel_validate at 1, 2, 4 and all threads, to check how
+	validation of a large array scales with cores. Build it on its own,
+	with optimization, and run it on an otherwise idle machine:
+
+		g++ -std=c++11 -O2 -pthread -I../include parallel_timing.cpp -o parallel_timing
+		./parallel_timing [elements]
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "safe_data/parallel.h"
+#include "safe_data/validations.h"
+
+using safe_data::parallel_options;
+using safe_data::parallel_validate;
+using boost::mpl::int_;
+
+typedef safe_data::range_validation<int, int_<0>, int_<100> > score_validation;
+
+int main(int argc, char* argv[])
+{
+	std::size_t const size = argc > 1 ? std::strtoul(argv[1], 0, 10) : 100000000;
+	std::vector<int> values(size, 50);
+
+	unsigned const counts[] = { 1, 2, 4, 0 };
+	double base = 0;
+	for (unsigned c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c) {
+		parallel_options options;
+		options.threads = counts[c];
+
+		double best = 0;
+		for (int run = 0; run < 5; ++run) {
+			std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+			parallel_validate<score_validation>(values, options);
+			double const ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			if ( run == 0 || ms < best )
+				best = ms;
+		}
+		if ( c == 0 )
+			base = best;
+
+		unsigned const threads = counts[c] ? counts[c] : std::thread::hardware_concurrency();
+		std::cout << threads << " threads: " << best << " ms, " << base / best << "x" << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,104 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+File:
+	pmr_timing.cpp
+
+Created: 2026.10.18
+
+Description:
+	times a request that builds 64 validated strings, once with the default
+	allocator and once with each request's strings in a pmr arena that is
+	released when the request ends. It counts calls to the global operator
+	new, which the arena version should all but avoid. Requires C++17:
+
+		g++ -std=c++17 -O2 -I../include pmr_timing.cpp -o pmr_timing
+		./pmr_timing [requests]
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "safe_data/operators.h"
+#include "safe_data/safe.h"
+#include "safe_data/validations.h"
+
+// counts every allocation that reaches the global heap
+static long global_allocations = 0;
+
+void* operator new(std::size_t size)
+{
+	++global_allocations;
+	if ( void* p = std::malloc(size ? size : 1) )
+		return p;
+	throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+using safe_data::safe;
+using safe_data::str_length_validation;
+
+typedef safe<std::string, str_length_validation<std::string, boost::mpl::size_t<128> > > name;
+typedef safe<std::pmr::string, str_length_validation<std::pmr::string, boost::mpl::size_t<128> > > pmr_name;
+
+static int const fields = 64;
+static char const text[] = "a request field that is longer than the small string buffer";
+
+template <class F>
+double best_of(int runs, F f)
+{
+	double best = 0;
+	for (int run = 0; run < runs; ++run) {
+		std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+		f();
+		double const ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		if ( run == 0 || ms < best )
+			best = ms;
+	}
+	return best;
+}
+
+int main(int argc, char* argv[])
+{
+	long const requests = argc > 1 ? std::strtol(argv[1], 0, 10) : 10000;
+	int const runs = 5;
+
+	long before = global_allocations;
+	double const heap = best_of(runs, [&] {
+		for (long r = 0; r < requests; ++r) {
+			std::vector<name> v;
+			v.reserve(fields);
+			for (int i = 0; i < fields; ++i) {
+				v.emplace_back(std::string(text));
+				v.back() += "-x";
+			}
+		}
+	});
+	long const heap_allocations = (global_allocations - before) / runs;
+
+	static char buffer[1 << 16];
+	before = global_allocations;
+	double const arena = best_of(runs, [&] {
+		for (long r = 0; r < requests; ++r) {
+			std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer));
+			std::pmr::vector<pmr_name> v(&resource);
+			v.reserve(fields);
+			for (int i = 0; i < fields; ++i) {
+				v.emplace_back(text);
+				v.back() += "-x";
+			}
+		}
+	});
+	long const arena_allocations = (global_allocations - before) / runs;
+
+	std::cout << requests << " requests of " << fields << " strings" << std::endl;
+	std::cout << "std::allocator: " << heap << " ms, " << heap_allocations << " global allocations" << std::endl;
+	std::cout << "pmr arena:      " << arena << " ms, " << arena_allocations << " global allocations, "
+		<< heap / arena << "x" << std::endl;
+	return 0;
+}
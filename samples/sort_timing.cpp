@@ -0,0 +1,77 @@
+/*
+Copyright Mike Naquin, 2026. All rights reserved.
+File:
+	sort_timing.cpp
+
+Created: 2026.10.18
+
+Description:
+	times safe_sort against std::sort on uniformly distributed safe<int>
+	values bounded to ranges of 2^8, 2^16, 2^24 and 2^31 values, and checks
+	that both produce the same order. Build it on its own, with
+	optimization:
+
+		g++ -std=c++11 -O2 -I../include sort_timing.cpp -o sort_timing
+		./sort_timing [elements]
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <boost/mpl/integral_c.hpp>
+
+#include "safe_data/compare.h"
+#include "safe_data/sort.h"
+
+using safe_data::safe;
+using safe_data::safe_sort;
+using boost::mpl::integral_c;
+
+template <int upper>
+struct bounded {
+	typedef safe<int, safe_data::range_validation<int, integral_c<int, 0>, integral_c<int, upper> > > type;
+};
+
+template <int upper>
+void run(char const* name, std::size_t size)
+{
+	typedef typename bounded<upper>::type value;
+
+	std::mt19937 gen(1);
+	std::uniform_int_distribution<int> dist(0, upper);
+	std::vector<value> a;
+	a.reserve(size);
+	for (std::size_t i = 0; i < size; ++i)
+		a.push_back(value(dist(gen)));
+	std::vector<value> b(a);
+
+	std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+	std::sort(b.begin(), b.end());
+	std::chrono::steady_clock::time_point const middle = std::chrono::steady_clock::now();
+	safe_sort(a);
+	std::chrono::steady_clock::time_point const end = std::chrono::steady_clock::now();
+
+	bool same = true;
+	for (std::size_t i = 0; i < size; ++i)
+		same = same && a[i].data() == b[i].data();
+
+	double const std_ms = std::chrono::duration<double, std::milli>(middle - start).count();
+	double const safe_ms = std::chrono::duration<double, std::milli>(end - middle).count();
+	std::cout << "range " << name << ": std::sort " << std_ms << " ms, safe_sort " << safe_ms << " ms, "
+		<< std_ms / safe_ms << "x" << (same ? "" : ", ORDER DIFFERS") << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t const size = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000000;
+	std::cout << size << " values" << std::endl;
+	run<(1 << 8) - 1>("2^8", size);
+	run<(1 << 16) - 1>("2^16", size);
+	run<(1 << 24) - 1>("2^24", size);
+	run<2147483646>("2^31", size);
+	return 0;
+}
@@ -266,3 +266,1249 @@ TEST(SafeData, Example)
 {
     EXPECT_NO_THROW(example());
 }
+
+#include "safe_data/mapped_array.h"
+
+#include <cstdio>
+#include <vector>
+
+using safe_data::mapped_safe_array;
+using safe_data::element_exception;
+
+typedef range_validation<int, int_<0>, int_<100> > score_validation;
+
+static string write_ints(std::vector<int> const& values)
+{
+	string path = ::testing::TempDir() + "safe_data_mapped.bin";
+	std::FILE* f = std::fopen(path.c_str(), "wb");
+	std::fwrite(values.data(), sizeof(int), values.size(), f);
+	std::fclose(f);
+	return path;
+}
+
+TEST(SafeDataTest, MappedArray)
+{
+	std::vector<int> values(300000, 42);
+	string path = write_ints(values);
+
+	{
+		mapped_safe_array<int, score_validation> scores(path);
+		EXPECT_EQ(values.size(), scores.size());
+		EXPECT_EQ(42, scores[0]);
+		EXPECT_EQ(42, scores.at(values.size() - 1));
+		EXPECT_THROW(scores.at(values.size()), std::out_of_range);
+		EXPECT_THROW(scores.set(0, 1), std::logic_error);
+	}
+	{
+		mapped_safe_array<int, score_validation> scores(path, safe_data::map_read_write);
+		EXPECT_THROW(scores.set(1, 101), score_validation::exception_type);
+		EXPECT_EQ(42, scores[1]);
+		scores.set(1, 7);
+		EXPECT_EQ(7, scores[1]);
+	}
+
+	values[5] = -1;
+	values[250000] = 101;
+	path = write_ints(values);
+	try {
+		mapped_safe_array<int, score_validation> scores(path);
+		ADD_FAILURE() << "expected element_exception";
+	}
+	catch (element_exception const& e) {
+		ASSERT_EQ(2u, e.positions().size());
+		EXPECT_EQ(5u, e.positions()[0]);
+		EXPECT_EQ(250000u, e.positions()[1]);
+	}
+	std::remove(path.c_str());
+}
+
+#include "safe_data/parallel.h"
+
+using safe_data::parallel_options;
+using safe_data::parallel_validate;
+using safe_data::parallel_find_invalid;
+using safe_data::elements_validation;
+
+// throws something other than a std::exception
+struct negative_validation {
+	static void validate(int v) { if ( v < 0 ) throw v; }
+};
+
+// fails for a reason other than an invalid element
+struct broken_scan_validation {
+	static void validate(int) { }
+	static std::size_t find_invalid(int const*, std::size_t) { throw std::bad_alloc(); }
+};
+
+TEST(SafeDataTest, ParallelValidate)
+{
+	std::vector<int> values(1000000, 50);
+	EXPECT_NO_THROW(parallel_validate<score_validation>(values));
+
+	values[123457] = 101;
+	values[999999] = -5;
+	values[4] = 200;
+
+	parallel_options options;
+	options.threads = 4;
+	options.chunk_size = 1000;
+	EXPECT_EQ(4u, (parallel_find_invalid<score_validation>(values.data(), values.size(), options)));
+
+	try {
+		parallel_validate<score_validation>(values, options);
+		ADD_FAILURE() << "expected element_exception";
+	}
+	catch (element_exception const& e) {
+		ASSERT_EQ(1u, e.positions().size());
+		EXPECT_EQ(4u, e.positions()[0]);
+	}
+
+	options.mode = safe_data::collect_all_failures;
+	try {
+		parallel_validate<score_validation>(values, options);
+		ADD_FAILURE() << "expected element_exception";
+	}
+	catch (element_exception const& e) {
+		ASSERT_EQ(3u, e.positions().size());
+		EXPECT_EQ(4u, e.positions()[0]);
+		EXPECT_EQ(123457u, e.positions()[1]);
+		EXPECT_EQ(999999u, e.positions()[2]);
+	}
+
+	EXPECT_EQ(999999u, (parallel_find_invalid<negative_validation>(values.data(), values.size(), options)));
+	EXPECT_THROW(parallel_validate<broken_scan_validation>(values, options), std::bad_alloc);
+}
+
+typedef safe<std::vector<int>, elements_validation<std::vector<int>, score_validation> > safe_scores;
+
+TEST(SafeDataTest, ElementsValidation)
+{
+	std::vector<int> values(10, 1);
+	safe_scores s(values);
+	EXPECT_EQ(10u, s.data().size());
+
+	values[3] = 101;
+	EXPECT_THROW(s = values, safe_scores::validation_type::exception_type);
+	EXPECT_EQ(1, s.data()[3]);
+}
+
+typedef safe<std::vector<int>, safe_data::size_validation<std::vector<int>, boost::mpl::size_t<3> > > safe_vec;
+
+TEST(SafeDataTest, ContainerModify)
+{
+	safe_vec v;
+	v.push_back(1);
+	v.emplace_back(2);
+	v.insert(v.data().begin(), 0);
+	EXPECT_EQ(3u, v.data().size());
+	EXPECT_EQ(0, v.data()[0]);
+
+	// size is checked before the container changes
+	EXPECT_THROW(v.push_back(3), safe_vec::validation_type::exception_type);
+	EXPECT_THROW(v.resize(4), safe_vec::validation_type::exception_type);
+	EXPECT_EQ(3u, v.data().size());
+
+	v.erase(v.data().begin());
+	EXPECT_EQ(1, v.data()[0]);
+	v.reserve(3);
+
+	// a size-only validation keeps no copy of erased elements, so they need not be copyable
+	typedef std::vector<std::unique_ptr<int> > owned;
+	safe<owned, safe_data::size_validation<owned, boost::mpl::size_t<3> > > ptrs;
+	ptrs.push_back(std::unique_ptr<int>(new int(1)));
+	ptrs.push_back(std::unique_ptr<int>(new int(2)));
+	ptrs.erase(ptrs.data().begin());
+	ASSERT_EQ(1u, ptrs.data().size());
+	EXPECT_EQ(2, *ptrs.data()[0]);
+
+	EXPECT_THROW(v.modify([](std::vector<int>& d) { d.assign(5, 0); }),
+	             safe_vec::validation_type::exception_type);
+	EXPECT_EQ(2u, v.data().size());
+	EXPECT_EQ(1, v.data()[0]);
+
+	// element validation is checked afterwards and rolled back
+	safe_scores s(std::vector<int>(3, 10));
+	EXPECT_THROW(s.push_back(101), safe_scores::validation_type::exception_type);
+	EXPECT_THROW(s.insert(s.data().begin() + 1, -1), safe_scores::validation_type::exception_type);
+	EXPECT_THROW(s.resize(5, 200), safe_scores::validation_type::exception_type);
+	EXPECT_EQ(std::vector<int>(3, 10), s.data());
+	s.erase(s.data().begin(), s.data().begin() + 2);
+	EXPECT_EQ(1u, s.data().size());
+}
+
+#include "safe_data/deferred.h"
+
+using safe_data::deferred_validation;
+using safe_data::edit;
+
+TEST(SafeDataTest, DeferredValidation)
+{
+	safe_int i; // initial value set to 8
+
+	{
+		deferred_validation<safe_int> e = edit(i);
+		for (int n = 0; n < 1000; ++n)
+			++*e;       // far past the max of 32 without throwing
+		*e -= 990;
+		e.commit();     // validated once
+	}
+	EXPECT_EQ(18, i);
+
+	{
+		deferred_validation<safe_int> e = edit(i);
+		*e += 100;
+		EXPECT_THROW(e.commit(), safe_int::validation_type::exception_type);
+		EXPECT_EQ(18, i); // prior valid value kept
+		EXPECT_TRUE(e.active());
+		*e = 20;
+		e.commit();
+		EXPECT_THROW(e.commit(), std::logic_error);
+	}
+	EXPECT_EQ(20, i);
+
+	{
+		deferred_validation<safe_int> e = edit(i);
+		*e = 1;
+	} // never committed
+	EXPECT_EQ(20, i);
+}
+
+#include "safe_data/levels.h"
+
+using safe_data::leveled_validation;
+
+typedef max_validation<int, int_<32> > max32_validation;
+
+static int sampled_violations = 0;
+static void count_violation(std::exception const&) { ++sampled_violations; }
+
+TEST(SafeDataTest, ValidationLevels)
+{
+	typedef safe<int, leveled_validation<max32_validation, safe_data::validate_off> > off_int;
+	off_int off;
+	EXPECT_NO_THROW(off = 100);
+	EXPECT_EQ(100, off);
+
+	typedef safe<int, leveled_validation<max32_validation, safe_data::validate_debug_only> > debug_int;
+	debug_int debug;
+#ifndef NDEBUG
+	EXPECT_THROW(debug = 100, max32_validation::exception_type);
+#else
+	EXPECT_NO_THROW(debug = 100);
+#endif
+
+	// 1 in 4 writes is validated
+	typedef safe<int, leveled_validation<max32_validation, safe_data::validate_sampled, 4> > sampled_int;
+	sampled_int sampled;
+	int thrown = 0;
+	for (int n = 0; n < 4; ++n) {
+		try { sampled = 100; }
+		catch (max32_validation::exception_type const&) { ++thrown; }
+	}
+	EXPECT_EQ(1, thrown);
+
+	safe_data::violation_handler previous = safe_data::set_violation_handler(count_violation);
+	for (int n = 0; n < 8; ++n)
+		sampled = 100;
+	EXPECT_EQ(2, sampled_violations);
+	safe_data::set_violation_handler(previous);
+}
+
+#include "safe_data/span.h"
+
+using safe_data::safe_span;
+
+TEST(SafeDataTest, SafeSpan)
+{
+	int frame[6] = { 1, 2, 3, 4, 5, 6 };
+	safe_span<int, score_validation> view(frame, 6);
+	EXPECT_FALSE(view.dirty());
+	EXPECT_EQ(3, view[2]);
+
+	EXPECT_THROW(view.set(0, 101), score_validation::exception_type);
+	view.set(0, 100);
+	EXPECT_EQ(100, frame[0]);
+	EXPECT_FALSE(view.dirty());
+
+	view.mutable_data()[4] = -1; // not checked
+	EXPECT_TRUE(view.dirty());
+	EXPECT_THROW(view.revalidate(), element_exception);
+	EXPECT_TRUE(view.dirty());
+
+	frame[4] = 5;
+	view.revalidate();
+	EXPECT_FALSE(view.dirty());
+
+	std::vector<int> bad(3, 500);
+	EXPECT_THROW((safe_span<int, score_validation>(bad)), element_exception);
+}
+
+TEST(SafeDataTest, LengthMessage)
+{
+	try {
+		safe_str s(string(100, 'x'));
+		ADD_FAILURE() << "expected str_length_exception";
+	}
+	catch (safe_str::validation_type::exception_type const& e) {
+		EXPECT_EQ("The length 100 of \"" + string(32, 'x') + "...\" must not exceed 8.", e.what());
+	}
+}
+
+#if __cplusplus >= 201703L
+
+#include "safe_data/tokenizer.h"
+
+#include <string_view>
+
+using safe_data::tokenize;
+
+typedef safe<std::string_view, str_length_validation<std::string_view, boost::mpl::size_t<4> > > safe_field;
+
+TEST(SafeDataTest, StringViewTokens)
+{
+	std::string_view line = "ab,cde,,fghi";
+	std::vector<safe_field> fields;
+	for (safe_field f : tokenize<safe_field>(line, ','))
+		fields.push_back(f);
+
+	ASSERT_EQ(4u, fields.size());
+	EXPECT_EQ("cde", fields[1]);
+	EXPECT_EQ("", fields[2]);
+	EXPECT_EQ(line.data() + 8, fields[3].data().data()); // points into the input
+
+	EXPECT_TRUE(tokenize<safe_field>("", ',').begin() == tokenize<safe_field>("", ',').end());
+
+	std::string_view bad = "ab,toolong,c";
+	safe_data::token_range<safe_field> tokens = tokenize<safe_field>(bad, ',');
+	safe_data::token_range<safe_field>::iterator it = tokens.begin();
+	EXPECT_NO_THROW(++it);
+	EXPECT_FALSE(it.valid());
+	EXPECT_EQ("toolong", it.view());
+	EXPECT_THROW(*it, safe_field::validation_type::exception_type);
+	++it; // a caller can skip the bad field and carry on
+	EXPECT_TRUE(it.valid());
+	EXPECT_EQ("c", *it);
+	EXPECT_TRUE(++it == tokens.end());
+
+	std::vector<std::string_view> good;
+	safe_data::token_range<safe_field> first_bad = tokenize<safe_field>("toolong,ab", ',');
+	for (safe_data::token_range<safe_field>::iterator t = first_bad.begin(); t != first_bad.end(); ++t) {
+		if ( t.valid() )
+			good.push_back((*t).data());
+	}
+	ASSERT_EQ(1u, good.size()); // a bad first field does not make begin() throw
+	EXPECT_EQ("ab", good[0]);
+
+	safe_field f("abcd");
+	EXPECT_THROW(f = std::string_view("abcde"), safe_field::validation_type::exception_type);
+	EXPECT_EQ("abcd", f);
+}
+
+#endif
+
+#include "safe_data/record.h"
+
+#include <tuple>
+
+using safe_data::safe_record;
+using safe_data::depends_on;
+
+enum { rec_start, rec_end, rec_limit };
+
+static int ordered_checks = 0;
+static int limit_checks = 0;
+
+struct ordered_invariant {
+	typedef depends_on<rec_start, rec_end> fields;
+	template <class R> static void validate(R const& r)
+	{
+		++ordered_checks;
+		if ( r.template get<rec_end>() < r.template get<rec_start>() )
+			throw std::invalid_argument("start must not be after end");
+	}
+};
+
+struct limit_invariant {
+	typedef depends_on<rec_end, rec_limit> fields;
+	template <class R> static void validate(R const& r)
+	{
+		++limit_checks;
+		if ( r.template get<rec_end>() > r.template get<rec_limit>() )
+			throw std::invalid_argument("end must not exceed limit");
+	}
+};
+
+typedef safe<int, score_validation> score;
+typedef safe_record<std::tuple<score, score, score>, ordered_invariant, limit_invariant> span_record;
+
+TEST(SafeDataTest, Record)
+{
+	span_record r(score(10), score(20), score(50));
+	ordered_checks = limit_checks = 0;
+
+	r.set<rec_limit>(60); // only the limit invariant depends on it
+	EXPECT_EQ(0, ordered_checks);
+	EXPECT_EQ(1, limit_checks);
+	EXPECT_TRUE(r.changed(rec_limit));
+	EXPECT_FALSE(r.changed(rec_start));
+
+	EXPECT_THROW(r.set<rec_start>(30), std::invalid_argument);
+	EXPECT_EQ(10, r.get<rec_start>());
+	EXPECT_THROW(r.set<rec_start>(101), score::validation_type::exception_type);
+
+	// moving both ends at once passes although either change alone would not
+	ordered_checks = limit_checks = 0;
+	span_record::update u = r.begin_update();
+	u.set<rec_start>(40).set<rec_end>(45);
+	u.commit();
+	EXPECT_EQ(1, ordered_checks);
+	EXPECT_EQ(1, limit_checks);
+	EXPECT_EQ(40, r.get<rec_start>());
+	EXPECT_EQ(45, r.get<rec_end>());
+
+	// a failing batch leaves every field unchanged
+	r.clear_changed();
+	span_record::update bad = r.begin_update();
+	bad.set<rec_start>(0).set<rec_end>(90);
+	EXPECT_THROW(bad.commit(), std::invalid_argument);
+	EXPECT_EQ(40, r.get<rec_start>());
+	EXPECT_EQ(45, r.get<rec_end>());
+	EXPECT_EQ(0u, r.changed());
+}
+
+#include "safe_data/collect.h"
+
+#include <sstream>
+
+using safe_data::violation_sink;
+using safe_data::try_assign;
+
+TEST(SafeDataTest, CollectViolations)
+{
+	violation_sink sink(2);
+
+	int const rows[] = { 5, -1, 50, 101, 200 };
+	score s;
+	for (std::size_t row = 0; row < 5; ++row)
+		try_assign(s, rows[row], sink, row, 3);
+	EXPECT_EQ(50, s); // invalid rows were skipped
+
+	safe_str str;
+	EXPECT_FALSE(try_assign(str, string("much too long"), sink, 7, 1));
+	EXPECT_TRUE(try_assign(str, string("short"), sink));
+	EXPECT_EQ("short", str);
+	EXPECT_TRUE(safe_data::check<date_validation>(date(2026, 10, 18), sink));
+	EXPECT_FALSE(safe_data::check<date_validation>(date(), sink, 8));
+
+	EXPECT_EQ(5u, sink.total());
+	EXPECT_EQ(2u, sink.stored());
+	EXPECT_EQ(3u, sink.dropped());
+	EXPECT_EQ(3u, sink.count(safe_data::range_violation));
+	EXPECT_EQ(1u, sink.count(safe_data::length_violation));
+	EXPECT_EQ(1u, sink.count(safe_data::other_violation));
+
+	EXPECT_EQ(1u, sink[0].row);
+	EXPECT_EQ(3u, sink[0].column);
+	EXPECT_EQ(-1, sink[0].value);
+	EXPECT_EQ(0, sink[0].lower);
+	EXPECT_EQ(100, sink[0].upper);
+
+	std::ostringstream report;
+	sink.report(report);
+	EXPECT_EQ(0u, report.str().find("5 violation(s) (3 not stored), range 3, length 1, other 1\n"));
+}
+
+#if __cplusplus >= 202002L
+
+#include "safe_data/pattern.h"
+
+using safe_data::pattern_validation;
+
+typedef safe<string, pattern_validation<string, "[A-Za-z_][A-Za-z0-9_]*"> > identifier;
+typedef safe<std::string_view, pattern_validation<std::string_view, "\\d{4}-\\d{2}-\\d{2}T\\d{2}:\\d{2}:\\d{2}Z"> > timestamp;
+typedef pattern_validation<string, "0x[0-9a-fA-F]{1,8}u?"> hex_validation;
+
+TEST(SafeDataTest, PatternValidation)
+{
+	identifier id(string("_foo42"));
+	EXPECT_THROW(id = string("42foo"), identifier::validation_type::exception_type);
+	EXPECT_THROW(id = string(""), identifier::validation_type::exception_type);
+	EXPECT_EQ("_foo42", id);
+
+	EXPECT_NO_THROW(timestamp("2026-10-18T12:34:56Z"));
+	EXPECT_THROW(timestamp("2026-10-18 12:34:56Z"), timestamp::validation_type::exception_type);
+	EXPECT_THROW(timestamp("2026-10-18T12:34:56"), timestamp::validation_type::exception_type);
+
+	EXPECT_TRUE(hex_validation::is_valid("0x1f"));
+	EXPECT_TRUE(hex_validation::is_valid("0xDEADBEEFu"));
+	EXPECT_FALSE(hex_validation::is_valid("0x"));
+	EXPECT_FALSE(hex_validation::is_valid("0x123456789"));
+	EXPECT_FALSE(hex_validation::is_valid("0x1g"));
+}
+
+#endif
+
+#include "safe_data/charset.h"
+
+using safe_data::charset_validation;
+using safe_data::utf8_validation;
+using safe_data::str_length_charset_validation;
+
+typedef safe<string, charset_validation<string, safe_data::printable> > safe_label;
+typedef safe<string, utf8_validation<string> > safe_text;
+typedef safe<string, str_length_charset_validation<string, boost::mpl::size_t<40>, safe_data::alnum> > safe_code;
+
+TEST(SafeDataTest, Charsets)
+{
+	safe_label label(string("Hello, world! 0123456789 abcdefghijklmnopqrstuvwxyz"));
+	try {
+		label = string("Hello, world! 0123456789 abcdefghijklmnopqrst\tvwxyz");
+		FAIL();
+	}
+	catch (safe_label::validation_type::exception_type const& e) {
+		EXPECT_EQ(45u, e.offset());
+	}
+	EXPECT_EQ('H', get(label)[0]);
+
+	EXPECT_NO_THROW(safe_text(string("h\xC3\xA9llo w\xE2\x82\xACrld \xF0\x9F\x98\x80")));
+	EXPECT_THROW(safe_text(string("overlong \xC0\xAF")), safe_text::validation_type::exception_type);
+	EXPECT_THROW(safe_text(string("surrogate \xED\xA0\x80")), safe_text::validation_type::exception_type);
+	EXPECT_THROW(safe_text(string("truncated \xE2\x82")), safe_text::validation_type::exception_type);
+
+	EXPECT_NO_THROW(safe_code(string("ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789")));
+	EXPECT_THROW(safe_code(string("ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789abcde")), safe_code::validation_type::length_exception_type);
+	EXPECT_THROW(safe_code(string("ABCDEFGHIJKLMNOPQRSTUVWXYZ-0123456789")), safe_code::validation_type::exception_type);
+
+	violation_sink sink(2);
+	EXPECT_FALSE(safe_data::check<safe_code::validation_type>(string(41, 'A'), sink));
+	EXPECT_FALSE(safe_data::check<safe_code::validation_type>(string("AB-C"), sink));
+	EXPECT_EQ(safe_data::length_violation, sink[0].kind);
+	EXPECT_EQ(41, sink[0].value);
+	EXPECT_EQ(40, sink[0].upper);
+	EXPECT_EQ(safe_data::other_violation, sink[1].kind);
+}
+
+#if __cplusplus >= 201402L
+
+#include "safe_data/one_of.h"
+
+using safe_data::one_of_validation;
+
+enum opcode { op_load = 1, op_store = 2, op_jump = 0x40, op_halt = 0xFF };
+
+typedef safe<unsigned short, one_of_validation<unsigned short, 200, 201, 204, 301, 404, 503>, integral_c<unsigned short, 200> > safe_status;
+typedef safe<int, one_of_validation<int, -1, 7, 1000003, 0x7FFFFFFF> > safe_sparse;
+typedef safe<opcode, one_of_validation<opcode, op_load, op_store, op_halt>, integral_c<opcode, op_load> > safe_opcode;
+
+#if __cplusplus >= 202002L
+// ISO 3166-1 alpha-2 codes and XK
+typedef safe<string, safe_data::one_of_str_validation<string,
+	"AD", "AE", "AF", "AG", "AI", "AL", "AM", "AO", "AQ", "AR", "AS", "AT", "AU", "AW", "AX", "AZ",
+	"BA", "BB", "BD", "BE", "BF", "BG", "BH", "BI", "BJ", "BL", "BM", "BN", "BO", "BQ", "BR", "BS",
+	"BT", "BV", "BW", "BY", "BZ", "CA", "CC", "CD", "CF", "CG", "CH", "CI", "CK", "CL", "CM", "CN",
+	"CO", "CR", "CU", "CV", "CW", "CX", "CY", "CZ", "DE", "DJ", "DK", "DM", "DO", "DZ", "EC", "EE",
+	"EG", "EH", "ER", "ES", "ET", "FI", "FJ", "FK", "FM", "FO", "FR", "GA", "GB", "GD", "GE", "GF",
+	"GG", "GH", "GI", "GL", "GM", "GN", "GP", "GQ", "GR", "GS", "GT", "GU", "GW", "GY", "HK", "HM",
+	"HN", "HR", "HT", "HU", "ID", "IE", "IL", "IM", "IN", "IO", "IQ", "IR", "IS", "IT", "JE", "JM",
+	"JO", "JP", "KE", "KG", "KH", "KI", "KM", "KN", "KP", "KR", "KW", "KY", "KZ", "LA", "LB", "LC",
+	"LI", "LK", "LR", "LS", "LT", "LU", "LV", "LY", "MA", "MC", "MD", "ME", "MF", "MG", "MH", "MK",
+	"ML", "MM", "MN", "MO", "MP", "MQ", "MR", "MS", "MT", "MU", "MV", "MW", "MX", "MY", "MZ", "NA",
+	"NC", "NE", "NF", "NG", "NI", "NL", "NO", "NP", "NR", "NU", "NZ", "OM", "PA", "PE", "PF", "PG",
+	"PH", "PK", "PL", "PM", "PN", "PR", "PS", "PT", "PW", "PY", "QA", "RE", "RO", "RS", "RU", "RW",
+	"SA", "SB", "SC", "SD", "SE", "SG", "SH", "SI", "SJ", "SK", "SL", "SM", "SN", "SO", "SR", "SS",
+	"ST", "SV", "SX", "SY", "SZ", "TC", "TD", "TF", "TG", "TH", "TJ", "TK", "TL", "TM", "TN", "TO",
+	"TR", "TT", "TV", "TW", "TZ", "UA", "UG", "UM", "US", "UY", "UZ", "VA", "VC", "VE", "VG", "VI",
+	"VN", "VU", "WF", "WS", "XK", "YE", "YT", "ZA", "ZM", "ZW"
+> > country;
+#endif
+
+TEST(SafeDataTest, OneOf)
+{
+	safe_status status;
+	EXPECT_NO_THROW(status = 404);
+	EXPECT_THROW(status = 405, safe_status::validation_type::exception_type);
+	EXPECT_EQ(404, status);
+
+	EXPECT_NO_THROW(safe_sparse(-1));
+	EXPECT_NO_THROW(safe_sparse(1000003));
+	EXPECT_THROW(safe_sparse(0), safe_sparse::validation_type::exception_type);
+	EXPECT_THROW(safe_sparse(1000004), safe_sparse::validation_type::exception_type);
+
+	safe_opcode op;
+	EXPECT_NO_THROW(op = op_halt);
+	EXPECT_THROW(op = op_jump, safe_opcode::validation_type::exception_type);
+	EXPECT_EQ(op_halt, get(op));
+
+#if __cplusplus >= 202002L
+	typedef safe<string, safe_data::one_of_str_validation<string, "USD", "EUR", "JPY", "GBP"> > currency;
+	EXPECT_NO_THROW(currency(string("EUR")));
+	EXPECT_THROW(currency(string("eur")), currency::validation_type::exception_type);
+	EXPECT_THROW(currency(string("EURO")), currency::validation_type::exception_type);
+	EXPECT_THROW(currency(string("EUR\0", 4)), currency::validation_type::exception_type);
+
+	EXPECT_NO_THROW(country(string("NZ")));
+	EXPECT_NO_THROW(country(string("ZW")));
+	EXPECT_THROW(country(string("ZZ")), country::validation_type::exception_type);
+	EXPECT_THROW(country(string("N")), country::validation_type::exception_type);
+#endif
+}
+
+#endif
+
+#include "safe_data/floating.h"
+
+#include <limits>
+
+using safe_data::finite_validation;
+using safe_data::finite_range_validation;
+
+typedef finite_range_validation<double, int_<0>, int_<1> > unit_validation;
+typedef safe<double, unit_validation> safe_unit;
+
+TEST(SafeDataTest, Finite)
+{
+	double const nan = std::numeric_limits<double>::quiet_NaN();
+	double const inf = std::numeric_limits<double>::infinity();
+
+	// range_validation lets NaN through
+	EXPECT_NO_THROW((safe<double, range_validation<double, int_<0>, int_<1> > >(nan)));
+
+	safe_unit unit(0.5);
+	EXPECT_THROW(unit = nan, safe_unit::validation_type::exception_type);
+	EXPECT_THROW(unit = inf, safe_unit::validation_type::exception_type);
+	EXPECT_THROW(unit = 1.5, safe_unit::validation_type::exception_type);
+	EXPECT_NO_THROW(unit = 1.0);
+
+	typedef safe<float, finite_validation<float> > safe_finite;
+	EXPECT_NO_THROW(safe_finite(std::numeric_limits<float>::max()));
+	EXPECT_THROW(safe_finite(-std::numeric_limits<float>::infinity()), safe_finite::validation_type::exception_type);
+
+	std::vector<double> values(37, 0.25);
+	EXPECT_EQ(values.size(), unit_validation::find_invalid(values.data(), values.size()));
+	values[29] = nan;
+	values[33] = -inf;
+	EXPECT_EQ(29u, unit_validation::find_invalid(values.data(), values.size()));
+	try {
+		parallel_validate<unit_validation>(values, parallel_options(safe_data::collect_all_failures));
+		FAIL();
+	}
+	catch (element_exception const& e) {
+		ASSERT_EQ(2u, e.positions().size());
+		EXPECT_EQ(33u, e.positions()[1]);
+	}
+}
+
+#include "safe_data/hash.h"
+
+#include <map>
+#include <unordered_map>
+
+using safe_data::safe_hash;
+using safe_data::safe_equal;
+using safe_data::safe_less;
+
+TEST(SafeDataTest, Hash)
+{
+	EXPECT_EQ(std::hash<int>()(17), std::hash<safe_int>()(safe_int(17)));
+	EXPECT_EQ(std::hash<string>()("foo"), std::hash<safe_str>()(safe_str()));
+
+	std::unordered_map<safe_str, int> counts;
+	++counts[safe_str(string("bar"))];
+	++counts[safe_str(string("bar"))];
+	EXPECT_EQ(2, counts[safe_str(string("bar"))]);
+
+	std::unordered_map<safe_str, int, safe_hash, safe_equal> ids;
+	ids[safe_str(string("alice"))] = 1;
+	ids[safe_str(string("bob"))] = 2;
+	EXPECT_EQ(safe_hash()(string("bob")), safe_hash()(safe_str(string("bob"))));
+	EXPECT_TRUE(safe_equal()(string("bob"), safe_str(string("bob"))));
+
+	std::map<safe_str, int, safe_less> ranks(ids.begin(), ids.end());
+	EXPECT_EQ(2, ranks.find(safe_str(string("bob")))->second);
+
+#if __cplusplus >= 201402L
+	// a key longer than safe_str allows is simply not found
+	EXPECT_EQ(1, ranks.find(string("alice"))->second);
+	EXPECT_TRUE(ranks.find(string("much too long")) == ranks.end());
+#endif
+#if __cplusplus >= 202002L
+	EXPECT_EQ(safe_hash()(std::string_view("alice")), safe_hash()(string("alice")));
+	EXPECT_EQ(2, ids.find(std::string_view("bob"))->second);
+	EXPECT_EQ(1u, ids.count("alice"));
+	EXPECT_TRUE(ids.find("much too long") == ids.end());
+#endif
+}
+
+#include "safe_data/interned.h"
+
+#include <thread>
+
+typedef safe_data::interned_safe_string<safe_str::validation_type, 64> interned_str;
+
+TEST(SafeDataTest, Interned)
+{
+	EXPECT_EQ(sizeof(void*), sizeof(interned_str));
+
+	interned_str a(string("host")), b("host"), c(safe_str(string("other")));
+	std::size_t const pooled = interned_str::pool_size();
+	EXPECT_TRUE(a == b);
+	EXPECT_TRUE(a != c);
+	EXPECT_TRUE(a < c);
+	EXPECT_EQ(a.data(), b.data());
+	EXPECT_EQ(std::hash<interned_str>()(a), std::hash<interned_str>()(b));
+	EXPECT_EQ("host", a.str());
+	EXPECT_EQ("other", c.to_safe());
+
+	EXPECT_THROW(interned_str(string("much too long")), safe_str::validation_type::exception_type);
+	EXPECT_EQ(pooled, interned_str::pool_size());
+
+	std::vector<interned_str> found(8, a);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 8; ++t)
+		threads.push_back(std::thread([&found, t] {
+			for (int i = 0; i < 100; ++i)
+				interned_str(std::to_string(i));
+			found[t] = interned_str(string("shared"));
+		}));
+	for (std::size_t t = 0; t < threads.size(); ++t)
+		threads[t].join();
+	EXPECT_EQ(pooled + 101, interned_str::pool_size());
+	for (int t = 1; t < 8; ++t)
+		EXPECT_TRUE(found[0] == found[t]);
+}
+
+#include "safe_data/shared.h"
+
+using safe_data::shared_safe;
+
+typedef shared_safe<std::vector<int>, safe_vec::validation_type> shared_vec;
+
+TEST(SafeDataTest, SharedSafe)
+{
+	shared_vec a(std::vector<int>(2, 7));
+	shared_vec b(a);
+	EXPECT_TRUE(a.shares_with(b));
+	EXPECT_EQ(2, a.use_count());
+	EXPECT_TRUE(a == b);
+
+	// detach on write; a keeps the old value
+	b.modify([](std::vector<int>& v) { v.push_back(8); });
+	EXPECT_FALSE(a.shares_with(b));
+	EXPECT_EQ(2u, a->size());
+	EXPECT_EQ(3u, b->size());
+	EXPECT_TRUE(a < b);
+
+	// unshared payload is updated in place
+	std::vector<int> const* payload = &b.data();
+	b.modify([](std::vector<int>& v) { v[0] = 1; });
+	EXPECT_EQ(payload, &b.data());
+
+	EXPECT_THROW(b.modify([](std::vector<int>& v) { v.push_back(9); }), safe_vec::validation_type::exception_type);
+	EXPECT_EQ(3u, b->size());
+	EXPECT_EQ(payload, &b.data());
+	EXPECT_THROW(b = std::vector<int>(4), safe_vec::validation_type::exception_type);
+	EXPECT_EQ(1, get(b)[0]);
+
+	// a moved-from shared_safe still holds its value
+	shared_vec moved(std::move(b));
+	EXPECT_TRUE(moved.shares_with(b));
+	EXPECT_EQ(3u, b->size());
+	a = std::move(moved);
+	EXPECT_EQ(3u, moved.data().size());
+	static_assert(std::is_nothrow_move_constructible<shared_vec>::value, "vector<shared_vec> must move on growth");
+
+	shared_vec c(safe_vec(std::vector<int>(1, 3)));
+	EXPECT_EQ(3, c.to_safe().data()[0]);
+}
+
+#include "safe_data/expression.h"
+
+using safe_data::lazy;
+
+typedef safe<int, range_validation<int, int_<-10000>, int_<10000> > > safe_wide;
+
+// bounds with no ::value, only a conversion
+SAFE_DATA_INITIAL_VALUE(fraction_min, double, 0.0)
+SAFE_DATA_INITIAL_VALUE(fraction_max, double, 1.0)
+typedef safe<double, range_validation<double, fraction_min, fraction_max> > fraction;
+
+TEST(SafeDataTest, LazyExpression)
+{
+	score a(90), b(20), c(5), d(95);
+
+	// the eager a + b is out of range even though the result is not
+	EXPECT_THROW(score(a + b - d), score::validation_type::exception_type);
+	score r = lazy(a) + b - d;
+	EXPECT_EQ(15, r);
+	EXPECT_THROW(r = lazy(a) + b, score::validation_type::exception_type);
+	EXPECT_EQ(15, r);
+
+	r = lazy(a) - lazy(b) * c + 12;
+	EXPECT_EQ(2, r);
+	r += lazy(d) - a;
+	EXPECT_EQ(7, r);
+	EXPECT_EQ(4, (lazy(b) & 6).eval());
+
+	// 0..100 * 0..100 - 0..100 always fits in safe_wide, so no validation is needed
+	typedef decltype(lazy(a) * b - c) product;
+	EXPECT_TRUE((safe_data::safe_detail::always_valid<product::node_type, safe_wide::validation_type>::value));
+	EXPECT_FALSE((safe_data::safe_detail::always_valid<product::node_type, score::validation_type>::value));
+	safe_wide w = lazy(a) * b - c;
+	EXPECT_EQ(1795, w);
+
+	fraction f(0.25), g(0.5);
+	fraction h = lazy(f) + g;
+	EXPECT_EQ(0.75, h);
+	EXPECT_THROW(h = lazy(g) + g + f, fraction::validation_type::exception_type);
+	EXPECT_EQ(0.75, h);
+}
+
+struct non_empty_validation {
+	typedef std::invalid_argument exception_type;
+	static bool is_valid(std::vector<int> const& v) { return !v.empty(); }
+	static void validate(std::vector<int> const& v) { if ( v.empty() ) throw exception_type("empty"); }
+};
+
+SAFE_DATA_INITIAL_VALUE(one_zero, std::vector<int>, std::vector<int>(1, 0))
+typedef safe<std::vector<int>, non_empty_validation, one_zero> non_empty_vec;
+
+TEST(SafeDataTest, MoveAndAllocator)
+{
+	safe_vec a(std::vector<int>(3, 1));
+	int const* storage = get(a).data();
+	safe_vec b(std::move(a));
+	EXPECT_EQ(storage, get(b).data());
+	EXPECT_TRUE(get(a).empty()); // an empty vector is valid, so it is kept
+
+	// a moved-from safe<> that would be invalid holds its initial value
+	non_empty_vec n(std::vector<int>(4, 2));
+	non_empty_vec m(std::move(n));
+	EXPECT_EQ(4u, get(m).size());
+	EXPECT_EQ(std::vector<int>(1, 0), get(n));
+	n = std::vector<int>(2, 3);
+	m = std::move(n);
+	EXPECT_EQ(2u, get(m).size());
+	EXPECT_NO_THROW(n.validate());
+
+	// so std::vector moves rather than copies its elements when it grows
+	static_assert(std::is_nothrow_move_constructible<safe_str>::value, "");
+	static_assert(std::is_nothrow_move_constructible<non_empty_vec>::value, "");
+	std::vector<non_empty_vec> grown(1, non_empty_vec(std::vector<int>(4, 2)));
+	storage = get(grown[0]).data();
+	grown.reserve(grown.capacity() + 1);
+	EXPECT_EQ(storage, get(grown[0]).data());
+
+	std::vector<int> raw(2, 5);
+	storage = raw.data();
+	b = std::move(raw);
+	EXPECT_EQ(storage, get(b).data());
+	EXPECT_THROW(b = std::vector<int>(4), safe_vec::validation_type::exception_type);
+
+	EXPECT_TRUE((std::uses_allocator<safe_vec, std::allocator<int> >::value));
+	EXPECT_FALSE((std::uses_allocator<safe_int, std::allocator<int> >::value));
+}
+
+#if __cplusplus >= 201703L
+
+#include <memory_resource>
+
+typedef safe<std::pmr::string, str_length_validation<std::pmr::string, boost::mpl::size_t<64> > > pmr_name;
+typedef safe<std::pmr::vector<int>, elements_validation<std::pmr::vector<int>, score_validation> > pmr_scores;
+
+TEST(SafeDataTest, PmrArena)
+{
+	// anything allocated outside the arena throws bad_alloc
+	char buffer[4096];
+	std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+	std::pmr::memory_resource* previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+	std::pmr::vector<pmr_name> names(&arena);
+	names.reserve(4);
+	EXPECT_NO_THROW(names.emplace_back("a name longer than the small string buffer"));
+	EXPECT_NO_THROW(names.push_back(names[0]));
+	EXPECT_NO_THROW(names[1] += "!");
+	EXPECT_THROW(names[1] += " and far too long to be a name", pmr_name::validation_type::exception_type);
+	EXPECT_THROW(names.emplace_back("a name that is much longer than the sixty-four characters allowed"),
+		pmr_name::validation_type::exception_type);
+
+	// the copies kept to roll back erase and resize come from the arena too
+	pmr_scores scores(std::allocator_arg, &arena);
+	scores.resize(6, 50);
+	EXPECT_NO_THROW(scores.erase(scores.data().begin()));
+	EXPECT_NO_THROW(scores.erase(scores.data().begin(), scores.data().begin() + 2));
+	EXPECT_NO_THROW(scores.resize(1));
+	EXPECT_EQ(1u, scores.data().size());
+
+	std::pmr::set_default_resource(previous);
+
+	ASSERT_EQ(2u, names.size());
+	EXPECT_EQ(&arena, names[1].get_allocator().resource());
+	EXPECT_EQ("a name longer than the small string buffer!", names[1].data());
+}
+
+#endif
+
+#include "safe_data/memoized.h"
+
+#include <atomic>
+#include <future>
+
+using safe_data::memoized_validation;
+
+struct counted_date_validation {
+	static int calls;
+	static void validate(date const& d) { ++calls; date_validation::validate(d); }
+};
+int counted_date_validation::calls = 0;
+
+struct julian_hash {
+	std::size_t operator() (date const& d) const { return d.is_special() ? 0 : d.julian_day(); }
+};
+
+typedef safe<date, memoized_validation<counted_date_validation, 16, julian_hash>, date_initial> memo_date;
+
+// a reference table with one entry
+std::atomic<int> table_code(7);
+
+struct table_validation {
+	typedef std::invalid_argument exception_type;
+	static void validate(int v) { if ( v != table_code.load() ) throw exception_type("not in the table"); }
+};
+
+TEST(SafeDataTest, Memoized)
+{
+	typedef memo_date::validation_type memo;
+	memo_date d;
+	memo::reset_stats();
+	counted_date_validation::calls = 0;
+
+	for (int i = 0; i < 3; ++i)
+		d = date(2001, 1, 1);
+	EXPECT_EQ(1, counted_date_validation::calls);
+	EXPECT_EQ(2u, memo::stats().hits);
+	EXPECT_EQ(1u, memo::stats().misses);
+
+	// dates 16 days apart share a slot and replace each other
+	d = date(2001, 1, 17);
+	d = date(2001, 1, 1);
+	EXPECT_EQ(3, counted_date_validation::calls);
+
+	// invalid values are never cached
+	EXPECT_THROW(d = date(), std::runtime_error);
+	EXPECT_THROW(d = date(), std::runtime_error);
+	EXPECT_EQ(5, counted_date_validation::calls);
+	EXPECT_EQ(date(2001, 1, 1), d.data());
+
+	// each thread has its own cache
+	std::thread([] { memo_date other(date(2001, 1, 1)); }).join();
+	EXPECT_EQ(6, counted_date_validation::calls);
+
+	memo::clear<date>();
+	d = date(2001, 1, 1);
+	EXPECT_EQ(7, counted_date_validation::calls);
+	EXPECT_NEAR(2.0 / 8.0, memo::stats().hit_rate(), 1e-9);
+
+	// clear() reaches values cached by another thread
+	typedef memoized_validation<table_validation> memo_table;
+	std::promise<void> cached, cleared;
+	std::future<void> cleared_future = cleared.get_future();
+	bool rejected = false;
+	std::thread worker([&] {
+		memo_table::validate(7);
+		cached.set_value();
+		cleared_future.wait();
+		try {
+			memo_table::validate(7);
+		}
+		catch (table_validation::exception_type const&) {
+			rejected = true;
+		}
+	});
+	cached.get_future().wait();
+	table_code = 8;
+	memo_table::clear<int>();
+	cleared.set_value();
+	worker.join();
+	EXPECT_TRUE(rejected);
+
+	// is_valid() goes through the cache, and the exception type is forwarded
+	static_assert(std::is_same<memo_table::exception_type, table_validation::exception_type>::value, "");
+	memo_table::reset_stats();
+	EXPECT_TRUE(memo_table::is_valid(8));
+	EXPECT_TRUE(memo_table::is_valid(8));
+	EXPECT_FALSE(memo_table::is_valid(7));
+	EXPECT_EQ(1u, memo_table::stats().hits);
+	EXPECT_EQ(2u, memo_table::stats().misses);
+}
+
+#include "safe_data/async.h"
+
+#include <atomic>
+
+using safe_data::assign_async;
+using safe_data::pending_assignment;
+using safe_data::validation_pool;
+
+std::atomic<bool> slow_gate(true);
+
+struct slow_validation {
+	static void validate(int const& i) {
+		while ( !slow_gate.load() )
+			std::this_thread::yield();
+		score_validation::validate(i);
+	}
+};
+
+typedef safe<int, slow_validation> slow_score;
+
+TEST(SafeDataTest, AsyncValidation)
+{
+	validation_pool pool(1, 4);
+	slow_score s(10);
+
+	slow_gate = false;
+	pending_assignment<slow_score> p = assign_async(s, 20, pool);
+	EXPECT_FALSE(p.ready());
+	EXPECT_EQ(10, s.data());   // readers see the last committed value
+	EXPECT_EQ(20, p.value());
+	slow_gate = true;
+	EXPECT_EQ(20, p.commit().data());
+	EXPECT_FALSE(p.pending());
+	EXPECT_THROW(p.commit(), std::logic_error);
+
+	pending_assignment<slow_score> bad = assign_async(s, 1000, pool);
+	EXPECT_THROW(bad.commit(), score_validation::exception_type);
+	EXPECT_EQ(20, s.data());
+
+	// uncommitted assignments are discarded
+	{
+		pending_assignment<slow_score> dropped = assign_async(s, 30, pool);
+		dropped.wait();
+	}
+	EXPECT_EQ(20, s.data());
+
+	std::vector<pending_assignment<slow_score> > batch;
+	std::vector<slow_score> targets(8);
+	for (int i = 0; i < 8; ++i)
+		batch.push_back(assign_async(targets[i], i * 10, pool));
+	for (int i = 0; i < 8; ++i)
+		EXPECT_EQ(i * 10, batch[i].commit().data());
+
+	// a pool that is shutting down takes no more work
+	pool.shutdown();
+	EXPECT_THROW(assign_async(s, 40, pool), std::logic_error);
+	EXPECT_EQ(20, s.data());
+}
+
+// true when a + b names a valid expression
+template <class A, class B>
+struct can_add {
+	template <class X> static char test(decltype(std::declval<X const&>() + std::declval<B const&>())*);
+	template <class X> static long test(...);
+	static bool const value = sizeof(test<A>(0)) == sizeof(char);
+};
+
+TEST(SafeDataTest, ConstrainedOperators)
+{
+	safe_int i(5);
+
+	EXPECT_TRUE(i >= 5);
+	EXPECT_TRUE(i >= 4);
+	EXPECT_FALSE(i >= 6);
+	EXPECT_TRUE(6 >= i);
+	EXPECT_FALSE(4 >= i);
+	EXPECT_TRUE(i >= safe_int(5));
+	EXPECT_FALSE(safe_int(4) >= i);
+
+	// only operands the raw type accepts take part
+	static_assert(safe_data::is_safe<safe_int>::value, "");
+	static_assert(!safe_data::is_safe<int>::value, "");
+	static_assert(can_add<safe_int, int>::value, "");
+	static_assert(can_add<int, safe_int>::value, "");
+	static_assert(!can_add<safe_int, std::vector<int> >::value, "");
+	static_assert(!can_add<std::vector<int>, safe_int>::value, "");
+	static_assert(can_add<safe_str, char const*>::value, "");
+}
+
+#if __cplusplus >= 201703L
+
+typedef safe<int, safe_data::range<0, 100> > nttp_score;
+typedef safe<long, safe_data::at_least<3L> > nttp_min;
+
+TEST(SafeDataTest, ConstantBounds)
+{
+	static_assert(safe_data::constant<42>() == 42, "");
+	static_assert(std::is_same<nttp_score::validation_type,
+		range_validation<int, safe_data::constant<0>, safe_data::constant<100> > >::value, "");
+
+	nttp_score s(100);
+	EXPECT_THROW(s = 101, nttp_score::validation_type::exception_type);
+	EXPECT_EQ(100, s);
+	EXPECT_THROW(nttp_min(2), std::out_of_range);
+
+	// the mpl spelling and the constant one are interchangeable
+	safe<int, range_validation<int, int_<0>, safe_data::constant<100> > > mixed(50);
+	EXPECT_EQ(50, mixed);
+
+#if __cplusplus >= 202002L
+	typedef safe<double, safe_data::range<0.0, 1.0> > ratio;
+	typedef safe<double, safe_data::at_most<1.0> > fraction;
+	EXPECT_NO_THROW(ratio(0.5));
+	EXPECT_THROW(ratio(1.5), std::out_of_range);
+	EXPECT_THROW(fraction(2.0), std::out_of_range);
+
+	safe<string, str_length_validation<string, safe_data::constant<std::size_t(8)> >, safe_data::initial<"foo"> > name;
+	EXPECT_EQ("foo", name);
+	EXPECT_THROW(name = "far too long", std::length_error);
+#endif
+}
+
+#endif
+
+#include "safe_data/sort.h"
+
+#include <algorithm>
+#include <random>
+
+using safe_data::safe_sort;
+
+typedef safe<int, range_validation<int, int_<-1000>, int_<1000> > > narrow_int;
+typedef safe<long long, range_validation<long long, boost::mpl::integral_c<long long, -1000000000LL>,
+	boost::mpl::integral_c<long long, 1000000000LL> > > wide_int;
+
+template <class Safe>
+static void expect_sorted_like_std(int lower, int upper, std::size_t n)
+{
+	std::mt19937 gen(42);
+	std::uniform_int_distribution<int> dist(lower, upper);
+	std::vector<Safe> v;
+	std::vector<typename Safe::raw_type> expected;
+	for (std::size_t i = 0; i < n; ++i) {
+		v.push_back(Safe(dist(gen)));
+		expected.push_back(v.back().data());
+	}
+	safe_sort(v);
+	std::sort(expected.begin(), expected.end());
+	ASSERT_EQ(n, v.size());
+	for (std::size_t i = 0; i < n; ++i)
+		ASSERT_EQ(expected[i], v[i].data());
+}
+
+TEST(SafeDataTest, SafeSort)
+{
+	using safe_data::safe_detail::sort_traits;
+	static_assert(sort_traits<narrow_int>::method == safe_data::safe_detail::sort_counting, "");
+	static_assert(sort_traits<wide_int>::method == safe_data::safe_detail::sort_radix, "");
+	static_assert(sort_traits<safe_int>::method == safe_data::safe_detail::sort_compare, "");
+
+	expect_sorted_like_std<narrow_int>(-1000, 1000, 10000);
+	expect_sorted_like_std<narrow_int>(-1000, 1000, 20);
+	expect_sorted_like_std<wide_int>(-1000000000, 1000000000, 10000);
+	expect_sorted_like_std<wide_int>(5, 9, 1000);   // only the low byte differs
+	expect_sorted_like_std<safe_int>(0, 32, 1000);
+
+	std::vector<safe_str> names;
+	names.push_back(safe_str("b"));
+	names.push_back(safe_str("a"));
+	safe_sort(names);
+	EXPECT_EQ("a", names[0]);
+
+	// bounds without ::value are not static, so std::sort is used
+	static_assert(sort_traits<fraction>::method == safe_data::safe_detail::sort_compare, "");
+	std::vector<fraction> fractions(2, fraction(0.75));
+	fractions[1] = 0.25;
+	safe_sort(fractions);
+	EXPECT_EQ(0.25, fractions[0]);
+
+	// a value outside the bounds, as an NDEBUG default can be, falls back to std::sort
+	std::vector<narrow_int> counted(1000, narrow_int(7));
+	counted[500] = narrow_int(safe_data::unchecked, 5000);
+	counted[501] = narrow_int(safe_data::unchecked, -5000);
+	safe_sort(counted);
+	EXPECT_EQ(-5000, counted.front());
+	EXPECT_EQ(5000, counted.back());
+
+	std::vector<wide_int> radixed(1000, wide_int(7));
+	radixed[500] = wide_int(safe_data::unchecked, 5000000000LL);
+	safe_sort(radixed);
+	EXPECT_EQ(5000000000LL, radixed.back());
+}
+
+#include "safe_data/index.h"
+
+using safe_data::safe_index_map;
+using safe_data::safe_index_set;
+using safe_data::safe_index_bitset;
+
+typedef safe<int, range_validation<int, int_<1>, int_<65535> >, int_<1> > port;
+
+TEST(SafeDataTest, IndexMap)
+{
+	// a port that starts at 0 would be out of range when NDEBUG skips validation
+	using safe_data::safe_detail::initial_in_bounds;
+	static_assert(initial_in_bounds<port>::value, "");
+	static_assert(!initial_in_bounds<safe<int, range_validation<int, int_<1>, int_<65535> > > >::value, "");
+	static_assert(initial_in_bounds<narrow_int>::value, "");
+	static_assert(!initial_in_bounds<safe<double, range_validation<double, fraction_min, fraction_max>, fraction_min> >::value, "");
+
+	safe_index_map<port, string> services;
+	EXPECT_EQ(65535u, services.capacity);
+	EXPECT_TRUE(services.empty());
+
+	services[port(443)] = "https";
+	EXPECT_TRUE(services.insert(port(22), "ssh"));
+	EXPECT_FALSE(services.insert(port(22), "telnet"));
+	EXPECT_TRUE(services.insert(port(65535), "last"));
+	EXPECT_EQ(3u, services.size());
+	EXPECT_EQ("ssh", *services.find(port(22)));
+	EXPECT_TRUE(services.find(port(80)) == 0);
+	EXPECT_TRUE(services.contains(port(1)) == false);
+
+	std::vector<int> keys;
+	services.for_each([&keys](port p, string const&) { keys.push_back(p.data()); });
+	ASSERT_EQ(3u, keys.size());
+	EXPECT_EQ(22, keys[0]);
+	EXPECT_EQ(65535, keys[2]);
+
+	EXPECT_TRUE(services.erase(port(443)));
+	EXPECT_FALSE(services.erase(port(443)));
+	EXPECT_EQ(2u, services.size());
+	services.clear();
+	EXPECT_TRUE(services.empty());
+	EXPECT_TRUE(services.find(port(22)) == 0);
+
+	EXPECT_THROW(services[port(safe_data::unchecked, 0)], std::out_of_range);
+	EXPECT_THROW(services.contains(port(safe_data::unchecked, 65536)), std::out_of_range);
+	EXPECT_TRUE(services.empty());
+}
+
+template <class Set>
+static void expect_index_set()
+{
+	Set s;
+	EXPECT_TRUE(s.insert(narrow_int(-1000)));
+	EXPECT_TRUE(s.insert(narrow_int(63)));
+	EXPECT_TRUE(s.insert(narrow_int(1000)));
+	EXPECT_FALSE(s.insert(narrow_int(63)));
+	EXPECT_EQ(3u, s.size());
+	EXPECT_TRUE(s.contains(narrow_int(63)));
+	EXPECT_FALSE(s.contains(narrow_int(64)));
+
+	std::vector<int> keys;
+	s.for_each([&keys](narrow_int k) { keys.push_back(k.data()); });
+	ASSERT_EQ(3u, keys.size());
+	EXPECT_EQ(-1000, keys[0]);
+	EXPECT_EQ(63, keys[1]);
+	EXPECT_EQ(1000, keys[2]);
+
+	EXPECT_TRUE(s.erase(narrow_int(63)));
+	EXPECT_FALSE(s.contains(narrow_int(63)));
+	s.clear();
+	EXPECT_TRUE(s.empty());
+}
+
+TEST(SafeDataTest, IndexSet)
+{
+	expect_index_set<safe_index_set<narrow_int> >();
+	expect_index_set<safe_index_bitset<narrow_int> >();
+}